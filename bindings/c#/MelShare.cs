@@ -27,17 +27,28 @@ using UnityEngine;
 
 class MelShare
 {
+    /// <summary>
+    /// Synchronization mode (must match mel::MelShare::Mode)
+    /// </summary>
+    public enum Mode
+    {
+        Locked,  // reads and writes are guarded by a named mutex
+        LockFree // single writer/multiple reader seqlock, writer never waits
+    }
+
     Mutex mutex_;
     SharedMemory shm_;
+    Mode mode_;
 
     /// <summary>
     /// Constructor
     /// </summary>
-    public MelShare(string name, long maxSize = 256)
+    public MelShare(string name, long maxSize = 256, Mode mode = Mode.Locked)
     {
+        mode_ = mode;
         try
         {
-            shm_ = new SharedMemory(name);
+            shm_ = new SharedMemory(name, (uint)maxSize);
             mutex_ = new Mutex(false, name + "_mutex");
             Debug.Log("Opened MelShare " + name);
         }
@@ -61,7 +72,19 @@ class MelShare
     public void WriteData(double[] data)
     {
         uint size = (uint)(data.Length * sizeof(double));
-        if ((size + sizeof(uint)) <= shm_.MaxSize)
+        if (mode_ == Mode.LockFree)
+        {
+            if ((size + 2 * sizeof(uint)) <= shm_.MaxSize)
+            {
+                int seq = BeginWrite();
+                Marshal.WriteInt32(shm_.Offset(sizeof(uint)), (int)size);
+                Marshal.Copy(data, 0, shm_.Offset(2 * sizeof(uint)), data.Length);
+                EndWrite(seq);
+            }
+            else
+                Debug.Log("MelShare " + shm_.Name + " failed to write data. Data is larger than max size of " + shm_.MaxSize + " bytes");
+        }
+        else if ((size + sizeof(uint)) <= shm_.MaxSize)
         {
             mutex_.WaitOne();
             byte[] sizeBytes = BitConverter.GetBytes(size);
@@ -79,6 +102,18 @@ class MelShare
     public double[] ReadData()
     {
         double[] data;
+        if (mode_ == Mode.LockFree)
+        {
+            while (true)
+            {
+                int seq = BeginRead();
+                uint size = Math.Min((uint)Marshal.ReadInt32(shm_.Offset(sizeof(uint))), shm_.MaxSize - 2 * sizeof(uint));
+                data = new double[size / sizeof(double)];
+                Marshal.Copy(shm_.Offset(2 * sizeof(uint)), data, 0, data.Length);
+                if (EndRead(seq))
+                    return data;
+            }
+        }
         mutex_.WaitOne();
         uint size = GetSize();
         if (size > 0)
@@ -99,7 +134,20 @@ class MelShare
     {
         message += Char.MinValue; // add null terminator
         uint size = (uint)(message.Length);
-        if ((size + sizeof(uint)) <= shm_.MaxSize)
+        if (mode_ == Mode.LockFree)
+        {
+            if ((size + 2 * sizeof(uint)) <= shm_.MaxSize)
+            {
+                byte[] stringBytes = Encoding.ASCII.GetBytes(message);
+                int seq = BeginWrite();
+                Marshal.WriteInt32(shm_.Offset(sizeof(uint)), (int)size);
+                Marshal.Copy(stringBytes, 0, shm_.Offset(2 * sizeof(uint)), stringBytes.Length);
+                EndWrite(seq);
+            }
+            else
+                Debug.Log("MelShare " + shm_.Name + " failed to write message. Message is larger than max size of " + shm_.MaxSize + " bytes");
+        }
+        else if ((size + sizeof(uint)) <= shm_.MaxSize)
         {
             mutex_.WaitOne();
             byte[] sizeBytes = BitConverter.GetBytes(size);
@@ -119,6 +167,18 @@ class MelShare
     public string ReadMessage()
     {
         string message;
+        if (mode_ == Mode.LockFree)
+        {
+            while (true)
+            {
+                int seq = BeginRead();
+                uint size = Math.Min((uint)Marshal.ReadInt32(shm_.Offset(sizeof(uint))), shm_.MaxSize - 2 * sizeof(uint));
+                byte[] messageBytes = new byte[size > 0 ? size - 1 : 0]; // strip null terminator
+                Marshal.Copy(shm_.Offset(2 * sizeof(uint)), messageBytes, 0, messageBytes.Length);
+                if (EndRead(seq))
+                    return Encoding.ASCII.GetString(messageBytes);
+            }
+        }
         mutex_.WaitOne();
         uint size = GetSize();
         if (size > 0)
@@ -143,6 +203,47 @@ class MelShare
         return BitConverter.ToUInt32(sizeBytes, 0);
     }
 
+    /// <summary>
+    /// Makes the LockFree sequence odd to mark a frame as being written.
+    /// </summary>
+    private int BeginWrite()
+    {
+        int seq = Marshal.ReadInt32(shm_.Address);
+        Marshal.WriteInt32(shm_.Address, seq + 1);
+        Thread.MemoryBarrier();
+        return seq;
+    }
+
+    /// <summary>
+    /// Makes the LockFree sequence even to publish a written frame.
+    /// </summary>
+    private void EndWrite(int seq)
+    {
+        Thread.MemoryBarrier();
+        Marshal.WriteInt32(shm_.Address, seq + 2);
+    }
+
+    /// <summary>
+    /// Waits for an even LockFree sequence and returns it.
+    /// </summary>
+    private int BeginRead()
+    {
+        int seq;
+        while (((seq = Marshal.ReadInt32(shm_.Address)) & 1) != 0)
+            Thread.Yield();
+        Thread.MemoryBarrier();
+        return seq;
+    }
+
+    /// <summary>
+    /// Returns true if the LockFree sequence did not change during a read.
+    /// </summary>
+    private bool EndRead(int seq)
+    {
+        Thread.MemoryBarrier();
+        return Marshal.ReadInt32(shm_.Address) == seq;
+    }
+
 }
 
 //==============================================================================
@@ -293,15 +394,28 @@ using System.IO.MemoryMappedFiles;
 
 class MelShare
 {
+    /// <summary>
+    /// Synchronization mode (must match mel::MelShare::Mode)
+    /// </summary>
+    public enum Mode
+    {
+        Locked,  // reads and writes are guarded by a named mutex
+        LockFree // single writer/multiple reader seqlock, writer never waits
+    }
+
     MemoryMappedFile mmf;
     MemoryMappedViewAccessor accessor;
     Mutex mutex;
+    Mode mode;
+    int offset; // byte offset of the frame size from the start of the map
 
     /// <summary>
     /// Default constructor.
     /// </summary>
-    public MelShare(string name, long maxSize = 256)
+    public MelShare(string name, long maxSize = 256, Mode mode = Mode.Locked)
     {
+        this.mode = mode;
+        offset = mode == Mode.LockFree ? sizeof(uint) : 0;
         try
         {
             mmf = MemoryMappedFile.CreateOrOpen(name, maxSize);
@@ -321,12 +435,11 @@ class MelShare
     {
         try
         {
-            mutex.WaitOne();
+            uint seq = Lock();
             uint size = (uint)(data.Length * sizeof(double));
-            accessor.Write(0, size);
-            for (int i = 0; i < data.Length; ++i)
-                accessor.Write(sizeof(uint) + i * sizeof(double), data[i]);
-            mutex.ReleaseMutex();
+            accessor.Write(offset, size);
+            accessor.WriteArray(offset + sizeof(uint), data, 0, data.Length);
+            Unlock(seq);
         }
         catch
         {
@@ -341,13 +454,15 @@ class MelShare
     {
         try
         {
-            mutex.WaitOne();
-            uint length = GetSize() / sizeof(double);
-            double[] data = new double[length];
-            for (int i = 0; i < length; ++i)
-                data[i] = accessor.ReadDouble(sizeof(uint) + i * sizeof(double));
-            mutex.ReleaseMutex();
-            return data;
+            while (true)
+            {
+                uint seq = BeginRead();
+                uint length = GetSize() / sizeof(double);
+                double[] data = new double[length];
+                accessor.ReadArray(offset + sizeof(uint), data, 0, data.Length);
+                if (EndRead(seq))
+                    return data;
+            }
         }
         catch
         {
@@ -362,14 +477,13 @@ class MelShare
     {
         try
         {
-            mutex.WaitOne();
             message += Char.MinValue; // add null terminator
-            uint size = (uint)(message.Length);
-            accessor.Write(0, size);
             byte[] stringBytes = Encoding.ASCII.GetBytes(message);
-            for (int i = 0; i < stringBytes.Length; ++i)
-                accessor.Write(sizeof(uint) + i * sizeof(byte), stringBytes[i]);
-            mutex.ReleaseMutex();
+            uint seq = Lock();
+            uint size = (uint)(message.Length);
+            accessor.Write(offset, size);
+            accessor.WriteArray(offset + sizeof(uint), stringBytes, 0, stringBytes.Length);
+            Unlock(seq);
         }
         catch
         {
@@ -384,13 +498,15 @@ class MelShare
     {
         try
         {
-            mutex.WaitOne();
-            int length = (int)GetSize() / sizeof(byte);
-            byte[] message = new byte[length - 1];
-            for (int i = 0; i < length; ++i)
-                message[i] = accessor.ReadByte(sizeof(uint) + i * sizeof(byte));
-            mutex.ReleaseMutex();
-            return Encoding.ASCII.GetString(message);
+            while (true)
+            {
+                uint seq = BeginRead();
+                int length = (int)GetSize() / sizeof(byte);
+                byte[] message = new byte[length - 1]; // strip null terminator
+                accessor.ReadArray(offset + sizeof(uint), message, 0, message.Length);
+                if (EndRead(seq))
+                    return Encoding.ASCII.GetString(message);
+            }
         }
         catch
         {
@@ -403,7 +519,69 @@ class MelShare
     /// </summary>
     private uint GetSize()
     {
-        return accessor.ReadUInt32(0);
+        return Math.Min(accessor.ReadUInt32(offset), (uint)(accessor.Capacity - offset - sizeof(uint)));
+    }
+
+    /// <summary>
+    /// Takes the mutex (Locked) or makes the sequence odd (LockFree) before a write.
+    /// </summary>
+    private uint Lock()
+    {
+        if (mode == Mode.Locked)
+        {
+            mutex.WaitOne();
+            return 0;
+        }
+        uint seq = accessor.ReadUInt32(0);
+        accessor.Write(0, seq + 1);
+        Thread.MemoryBarrier();
+        return seq;
+    }
+
+    /// <summary>
+    /// Releases the mutex (Locked) or makes the sequence even (LockFree) after a write.
+    /// </summary>
+    private void Unlock(uint seq)
+    {
+        if (mode == Mode.Locked)
+        {
+            mutex.ReleaseMutex();
+            return;
+        }
+        Thread.MemoryBarrier();
+        accessor.Write(0, seq + 2);
+    }
+
+    /// <summary>
+    /// Takes the mutex (Locked) or waits for an even sequence (LockFree) before a read.
+    /// </summary>
+    private uint BeginRead()
+    {
+        if (mode == Mode.Locked)
+        {
+            mutex.WaitOne();
+            return 0;
+        }
+        uint seq;
+        while (((seq = accessor.ReadUInt32(0)) & 1) != 0)
+            Thread.Yield();
+        Thread.MemoryBarrier();
+        return seq;
+    }
+
+    /// <summary>
+    /// Releases the mutex (Locked) or checks the sequence is unchanged (LockFree)
+    /// after a read. Returns false if a LockFree read caught a torn frame.
+    /// </summary>
+    private bool EndRead(uint seq)
+    {
+        if (mode == Mode.Locked)
+        {
+            mutex.ReleaseMutex();
+            return true;
+        }
+        Thread.MemoryBarrier();
+        return accessor.ReadUInt32(0) == seq;
     }
 }
 
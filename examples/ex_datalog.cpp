@@ -18,9 +18,11 @@
 #include <MEL/Core/Timer.hpp>
 #include <MEL/Logging/DataLogger.hpp>
 #include <MEL/Logging/Log.hpp>
+#include <MEL/Math/Constants.hpp>
 #include <MEL/Math/Functions.hpp>
 #include <MEL/Core/Console.hpp>
 #include <MEL/Utility/System.hpp>
+#include <numeric>
 
 using namespace mel;
 
@@ -41,6 +43,23 @@ int main() {
     logger.save_data("datalogger_data.csv", "/data/");
 
 
+    // Real-time data logging with WriterType::Streaming
+
+    // rows are copied into an arena preallocated by open() and written to
+    // the file by a background thread, so buffer() never locks or allocates
+    DataLogger stream(WriterType::Streaming);
+    stream.set_header({"Time", "Position"});
+    stream.open("datalogger_stream.csv", "/data/");
+    Timer timer(hertz(1000));
+    for (std::size_t i = 0; i < 1000; ++i) {
+        double t = timer.get_elapsed_time().as_seconds();
+        double row[2] = {t, mel::sin(2 * PI * t)};
+        stream.buffer(row, 2);
+        timer.wait();
+    }
+    stream.close();
+
+
     // Advanced data logging with Tables
 
     std::string filename = "table_data.csv";
@@ -64,4 +83,9 @@ int main() {
             std::cout << new_tabs[i];
         }
     }
+
+    // Table columns are contiguous, so per-channel statistics copy nothing
+    Table::Column col = tabs[2].col(1);
+    double mean = std::accumulate(col.begin(), col.end(), 0.0) / col.size();
+    std::cout << "mean of " << tabs[2].get_col_name(1) << ": " << mean << std::endl;
 }
@@ -0,0 +1,86 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <MEL/Communications/EventLoop.hpp>
+#include <MEL/Core/Console.hpp>
+#include <MEL/Core/Timer.hpp>
+#include <MEL/Math/Constants.hpp>
+#include <MEL/Math/Functions.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// This example runs a 1 kHz "control loop" on the main thread while an
+// EventLoop on a background thread serves any number of TCP clients on port
+// 55001. Every client receives the latest position at 100 Hz and may send
+// the single byte 'q' to stop the server. Try it with e.g. netcat:
+//
+//     nc 127.0.0.1 55001
+
+using namespace mel;
+
+ctrl_bool stop(false);
+bool handler(CtrlEvent event) {
+    if (event == CtrlEvent::CtrlC)
+        stop = true;
+    return true;
+}
+
+int main() {
+    register_ctrl_handler(handler);
+
+    std::atomic<double> position(0.0);
+    std::vector<TcpSocket*> clients;
+
+    EventLoop loop;
+    loop.listen(55001, [&](TcpSocket& client, Socket::Status) {
+        print("Client connected");
+        clients.push_back(&client);
+        loop.on_readable(client, [&](TcpSocket& c) {
+            char command;
+            std::size_t received;
+            Socket::Status status = c.receive(&command, 1, received);
+            if (status == Socket::Done && command == 'q')
+                stop = true;
+            else if (status == Socket::Disconnected || status == Socket::Error) {
+                print("Client disconnected");
+                clients.erase(std::find(clients.begin(), clients.end(), &c));
+                loop.close(c);
+            }
+        });
+    });
+    loop.add_timer(milliseconds(10), [&]() {
+        double p = position.load();
+        for (std::size_t i = 0; i < clients.size(); ++i) {
+            std::size_t sent;
+            clients[i]->send(&p, sizeof(p), sent);
+        }
+    });
+    std::thread server([&]() { loop.run(); });
+
+    // control loop, never blocked by the clients
+    Timer timer(hertz(1000));
+    while (!stop) {
+        position = mel::sin(2 * PI * timer.get_elapsed_time().as_seconds());
+        timer.wait();
+    }
+
+    loop.stop();
+    server.join();
+    return 0;
+}
@@ -0,0 +1,76 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <MEL/Core/Console.hpp>
+#include <MEL/Core/Executor.hpp>
+#include <MEL/Logging/DataLogger.hpp>
+#include <MEL/Utility/System.hpp>
+#include <atomic>
+#include <cmath>
+
+using namespace mel;
+
+// Runs a 4 kHz current loop and a 1 kHz impedance loop on one thread and a
+// 100 Hz supervisory task on another, then prints each task's timing. Run
+// as root (sudo) for the threads to get SCHED_FIFO priorities.
+
+ctrl_bool stop(false);
+bool handler(CtrlEvent event) {
+    if (event == CtrlEvent::CtrlC)
+        stop = true;
+    return true;
+}
+
+int main() {
+    register_ctrl_handler(handler);
+
+    // shared state; atomics stand in for a real controller's data exchange
+    std::atomic<double> torque(0.0);
+    std::atomic<double> stiffness(100.0);
+    double current = 0.0;
+    double position = 0.0;
+
+    Executor executor;
+    executor.add_thread(0);  // thread 0 on core 0
+    executor.add_thread(1);  // thread 1 on core 1, if there is one
+
+    executor.add_task("current", hertz(4000), [&]() {
+        current += 0.1 * (torque - current);
+    }, 0);
+    executor.add_task("impedance", hertz(1000), [&]() {
+        position = std::sin(position + 0.001);
+        torque = -stiffness * position;
+    }, 0);
+    executor.add_task("supervisor", hertz(100), [&]() {
+        stiffness = std::abs(torque) > 50.0 ? 50.0 : 100.0;
+    }, 1);
+
+    print("Running for 5 s, press Ctrl+C to stop early");
+    executor.start();
+    for (int i = 0; i < 500 && !stop; ++i)
+        sleep(milliseconds(10));
+    executor.stop();
+
+    for (std::size_t i = 0; i < executor.get_task_count(); ++i) {
+        print(executor.get_task_name(i) + ": " +
+              std::to_string(executor.get_run_count(i)) + " runs, " +
+              std::to_string(executor.get_overrun_count(i)) + " overruns, p99 response " +
+              std::to_string(executor.get_response_time(i).get_percentile(99) / 1000) + " us");
+    }
+    DataLogger::write_to_csv(executor.get_stats_table(), "executor_stats.csv");
+    return 0;
+}
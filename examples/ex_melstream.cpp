@@ -0,0 +1,61 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+//
+#include <MEL/Communications/MelStream.hpp>
+#include <MEL/Core/Console.hpp>
+#include <MEL/Core/Timer.hpp>
+#include <MEL/Logging/Log.hpp>
+#include <vector>
+
+// Usage:
+// To run this example, open two terminals and run the following:
+//
+// Terminal 1: melstream.exe A   (10 kHz producer)
+// Terminal 2: melstream.exe B   (60 Hz consumer)
+
+using namespace mel;
+
+int main(int argc, char* argv[]) {
+    static ColorConsoleWriter<TxtFormatter> consoleAppender;
+
+    if (argc > 1) {
+        MelStream stream("melstream", 1024, 2);
+        std::string id = argv[1];
+        if (id == "A") {
+            Timer timer(hertz(10000));
+            for (int i = 0; i < 100000; ++i) {
+                double t = timer.get_elapsed_time().as_seconds();
+                stream.write_data({t, static_cast<double>(i)});
+                timer.wait();
+            }
+            print("Overruns: " + std::to_string(stream.get_overruns()));
+        }
+        else if (id == "B") {
+            Timer timer(hertz(60));
+            std::vector<double> samples;
+            std::size_t total = 0;
+            while (timer.get_elapsed_time() < seconds(15)) {
+                total += stream.read_all(samples);
+                if (!samples.empty())
+                    print(std::to_string(total) + " samples, last i = " +
+                          std::to_string(samples.back()));
+                timer.wait();
+            }
+        }
+    }
+    return 0;
+}
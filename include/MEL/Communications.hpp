@@ -18,16 +18,19 @@
 #ifndef COMMUNICATIONS_HPP
 #define COMMUNICATIONS_HPP
 
+#include <MEL/Communications/EventLoop.hpp>
 #include <MEL/Communications/Http.hpp>
 #include <MEL/Communications/IpAddress.hpp>
 #include <MEL/Communications/MelNet.hpp>
 #include <MEL/Communications/MelShare.hpp>
+#include <MEL/Communications/MelStream.hpp>
 #include <MEL/Communications/Packet.hpp>
 #include <MEL/Communications/SharedMemory.hpp>
 #include <MEL/Communications/Socket.hpp>
 #include <MEL/Communications/SocketSelector.hpp>
 #include <MEL/Communications/TcpListener.hpp>
 #include <MEL/Communications/TcpSocket.hpp>
+#include <MEL/Communications/TypedMelShare.hpp>
 #include <MEL/Communications/UdpSocket.hpp>
 
 #endif // COMMUNICATIONS_HPP
@@ -0,0 +1,98 @@
+#include <cassert>
+#include <cstring>
+
+namespace mel {
+
+    template <typename T>
+    TypedMelShare<T>::TypedMelShare(const std::string& name,
+                                    MelShare::Mode mode,
+                                    bool notify) :
+        ms_(name, (mode == MelShare::LockFree ? 2 : 1) * sizeof(uint32) + sizeof(T), mode, notify)
+    {
+        // the size prefix is written once by whoever opens the memory map first
+        uint32 seq;
+        uint32 size = ms_.begin_read(seq);
+        ms_.end_read(seq);
+        if (size == 0) {
+            T value = T();
+            ms_.write_frame(&value, static_cast<uint32>(sizeof(T)));
+        }
+    }
+
+    template <typename T>
+    void TypedMelShare<T>::write(const T& value) {
+        write_bytes(&value, sizeof(T), 0);
+    }
+
+    template <typename T>
+    T TypedMelShare<T>::read() {
+        T value;
+        read_bytes(&value, sizeof(T), 0);
+        return value;
+    }
+
+    template <typename T>
+    void TypedMelShare<T>::read(T& value) {
+        read_bytes(&value, sizeof(T), 0);
+    }
+
+    template <typename T>
+    template <typename F, typename U>
+    void TypedMelShare<T>::write(F U::*field, const F& value) {
+        write_bytes(&value, sizeof(F), offset_of(field));
+    }
+
+    template <typename T>
+    template <typename F, typename U>
+    F TypedMelShare<T>::read(F U::*field) {
+        F value;
+        read_bytes(&value, sizeof(F), offset_of(field));
+        return value;
+    }
+
+    template <typename T>
+    template <typename U>
+    typename U::value_type TypedMelShare<T>::operator[](std::size_t index) {
+        typename U::value_type value = typename U::value_type();
+        // the map holds exactly one T, so never read past its last element
+        if (index >= sizeof(T) / sizeof(value)) {
+            assert(!"TypedMelShare::operator[] index out of range");
+            return value;
+        }
+        read_bytes(&value, sizeof(value), index * sizeof(value));
+        return value;
+    }
+
+    template <typename T>
+    bool TypedMelShare<T>::wait_for_write(Time timeout) {
+        return ms_.wait_for_write(timeout);
+    }
+
+    template <typename T>
+    template <typename F, typename U>
+    std::size_t TypedMelShare<T>::offset_of(F U::*field) {
+        // offsetof for a pointer-to-member, computed on uninitialized storage
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        const U* object = reinterpret_cast<const T*>(&storage);
+        return static_cast<std::size_t>(
+            reinterpret_cast<const char*>(&(object->*field)) -
+            reinterpret_cast<const char*>(object));
+    }
+
+    template <typename T>
+    void TypedMelShare<T>::write_bytes(const void* data, std::size_t size, std::size_t offset) {
+        ms_.begin_write();
+        std::memcpy(ms_.payload() + offset, data, size);
+        ms_.end_write();
+    }
+
+    template <typename T>
+    void TypedMelShare<T>::read_bytes(void* data, std::size_t size, std::size_t offset) {
+        uint32 seq;
+        do {
+            ms_.begin_read(seq);
+            std::memcpy(data, ms_.payload() + offset, size);
+        } while (!ms_.end_read(seq));
+    }
+
+} // namespace mel
@@ -0,0 +1,167 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#ifndef MEL_EVENTLOOP_HPP
+#define MEL_EVENTLOOP_HPP
+
+#include <MEL/Config.hpp>
+#include <MEL/Communications/IpAddress.hpp>
+#include <MEL/Communications/Socket.hpp>
+#include <MEL/Communications/TcpSocket.hpp>
+#include <MEL/Communications/UdpSocket.hpp>
+#include <MEL/Core/NonCopyable.hpp>
+#include <MEL/Core/Time.hpp>
+#include <MEL/Core/Types.hpp>
+#include <functional>
+#include <memory>
+
+namespace mel {
+
+//==============================================================================
+// CLASS DECLARATION
+//==============================================================================
+
+/// Single threaded reactor that owns non-blocking sockets and dispatches
+/// callbacks when they connect, become readable or writable, and on timers
+class MEL_API EventLoop : NonCopyable {
+public:
+    /// Called when a TcpSocket is accepted or an outgoing connection completes.
+    /// The Status is Socket::Done on success.
+    typedef std::function<void(TcpSocket&, Socket::Status)> ConnectCallback;
+
+    /// Called when a TcpSocket is readable or writable
+    typedef std::function<void(TcpSocket&)> TcpCallback;
+
+    /// Called when a UdpSocket is readable
+    typedef std::function<void(UdpSocket&)> UdpCallback;
+
+    /// Called when a timer expires
+    typedef std::function<void()> TimerCallback;
+
+    /// Identifies a timer created with add_timer()
+    typedef uint32 TimerId;
+
+    /// Default constructor
+    EventLoop();
+
+    /// Destructor. Closes all sockets owned by the loop.
+    ~EventLoop();
+
+    /// Listens for TCP connections on #port. Every client is accepted into a
+    /// non-blocking TcpSocket owned by the loop and passed to #on_connect.
+    Socket::Status listen(unsigned short port, ConnectCallback on_connect,
+                          const IpAddress& address = IpAddress::Any);
+
+    /// Starts a non-blocking connection to #address:#port and returns the
+    /// TcpSocket owned by the loop, or NULL if it failed right away.
+    /// Otherwise #on_connect is called once the connection completes or
+    /// fails; a failed socket is closed after the callback.
+    TcpSocket* connect(const IpAddress& address, unsigned short port,
+                       ConnectCallback on_connect);
+
+    /// Binds a non-blocking UdpSocket owned by the loop to #port. Returns
+    /// NULL if the port could not be bound.
+    UdpSocket* bind(unsigned short port, const IpAddress& address = IpAddress::Any);
+
+    /// Calls #callback whenever #socket has data to receive or was
+    /// disconnected. Pass an empty callback to stop watching.
+    void on_readable(TcpSocket& socket, TcpCallback callback);
+
+    /// Calls #callback whenever #socket has datagrams to receive. Pass an
+    /// empty callback to stop watching.
+    void on_readable(UdpSocket& socket, UdpCallback callback);
+
+    /// Calls #callback once, the next time #socket can be written without
+    /// blocking (e.g. to resume after a Socket::Partial send)
+    void on_writable(TcpSocket& socket, TcpCallback callback);
+
+    /// Closes and destroys a socket owned by the loop. Safe to call from
+    /// within its own callbacks; the socket lives until they return.
+    void close(Socket& socket);
+
+    /// Returns the number of sockets owned by the loop
+    std::size_t get_socket_count() const;
+
+    /// Calls #callback after #period, and every #period after if #repeat
+    TimerId add_timer(Time period, TimerCallback callback, bool repeat = true);
+
+    /// Cancels a timer. Safe to call from within its own callback.
+    void cancel_timer(TimerId id);
+
+    /// Waits at most #timeout for events, then dispatches all ready socket
+    /// callbacks and expired timers. Returns the number of callbacks made.
+    std::size_t poll(Time timeout = Time::Inf);
+
+    /// Dispatches events until stop() is called
+    void run();
+
+    /// Makes run() return. May be called from any thread.
+    void stop();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;  ///< OS specific implementation
+};
+
+}  // namespace mel
+
+#endif  // MEL_EVENTLOOP_HPP
+
+//==============================================================================
+// CLASS DOCUMENTATION
+//==============================================================================
+
+/// \class mel::EventLoop
+/// \ingroup Communications
+///
+/// An EventLoop lets one thread serve many TCP and UDP peers without a thread
+/// per client or a hand written SocketSelector loop. Sockets are created by
+/// the loop (listen, connect, bind), are always non-blocking, and are
+/// destroyed with close() or with the loop. Callbacks run on the thread that
+/// calls poll() or run(), one at a time, so they need no locking between
+/// each other. Keep them short; anything slow delays every other peer.
+///
+/// Timers are measured with a Clock owned by the loop. A repeating timer is
+/// rescheduled from its previous deadline, so it does not drift, but it
+/// skips ahead rather than firing a burst if the loop fell behind.
+///
+/// On Linux the loop waits with epoll; elsewhere it uses select().
+///
+/// Usage example:
+/// \code
+/// EventLoop loop;
+/// std::vector<TcpSocket*> clients;
+/// loop.listen(55001, [&](TcpSocket& client, Socket::Status) {
+///     clients.push_back(&client);
+///     loop.on_readable(client, [&](TcpSocket& c) {
+///         char buffer[256];
+///         std::size_t received;
+///         if (c.receive(buffer, sizeof(buffer), received) == Socket::Disconnected) {
+///             clients.erase(std::find(clients.begin(), clients.end(), &c));
+///             loop.close(c);
+///         }
+///     });
+/// });
+/// loop.add_timer(milliseconds(10), [&]() {
+///     for (auto c : clients)
+///         c->send(&telemetry, sizeof(telemetry));
+/// });
+/// std::thread thread([&]() { loop.run(); });
+/// ...
+/// loop.stop();
+/// thread.join();
+/// \endcode
@@ -22,6 +22,8 @@
 #include <MEL/Communications/Packet.hpp>
 #include <MEL/Communications/UdpSocket.hpp>
 #include <MEL/Core/NonCopyable.hpp>
+#include <MEL/Core/Time.hpp>
+#include <MEL/Core/Types.hpp>
 #include <string>
 #include <vector>
 
@@ -34,18 +36,72 @@ namespace mel {
 /// High-level communication class that simplifies UDP communication
 class MEL_API MelNet : NonCopyable {
 public:
+    /// The wire format of a MelNet
+    enum Protocol {
+        Raw,    ///< bare payloads, compatible with MELScope and the bindings
+        Framed  ///< payloads prefixed with a versioned MelNet::Header
+    };
+
+    /// The kind of payload carried by a Framed datagram
+    enum Type {
+        Data    = 0,  ///< array of doubles
+        Message = 1,  ///< string characters without null terminator
+        Request = 2   ///< no payload
+    };
+
+    enum {
+        Magic   = 0x4E4C454D,  ///< reads "MELN" in memory on little endian hosts
+        Version = 1            ///< current Framed protocol version
+    };
+
+    /// Header prefixed to every Framed datagram (24 bytes). Fields are in
+    /// host byte order, so both ends must have the same endianness.
+    struct Header {
+        uint32 magic;      ///< MelNet::Magic
+        uint8  version;    ///< MelNet::Version
+        uint8  type;       ///< MelNet::Type of the payload
+        uint16 count;      ///< number of payload elements (doubles or chars)
+        uint32 sequence;   ///< sender sequence number, incremented per datagram
+        uint32 reserved;   ///< zero, keeps the payload 8 byte aligned
+        int64  timestamp;  ///< sender Clock::get_current_time() when sent [us]
+    };
+
     /// Default constructor. Use ports in the range of 49152 to 65535.
     MelNet(unsigned short local_port,
            unsigned short remote_port,
            IpAddress remote_address,
-           bool blocking = true);
+           bool blocking = true,
+           Protocol protocol = Raw);
 
     /// Sends a vector of doubles to the remote host
     void send_data(const std::vector<double>& data);
 
-    /// Receives a vector of doubles from the remote host
+    /// Sends #size doubles from #data to the remote host
+    void send_data(const double* data, std::size_t size);
+
+    /// Adds another host that broadcast_data() sends to, in addition to
+    /// the remote host given at construction
+    void add_peer(IpAddress address, unsigned short port);
+
+    /// Removes all hosts added with add_peer()
+    void clear_peers();
+
+    /// Sends a vector of doubles to the remote host and all peers
+    void broadcast_data(const std::vector<double>& data);
+
+    /// Sends #size doubles from #data to the remote host and all peers with
+    /// a single batched send
+    void broadcast_data(const double* data, std::size_t size);
+
+    /// Receives a vector of doubles from the remote host. In Framed mode,
+    /// a datagram older than data already returned is counted as reordered
+    /// and returns no data, so stale values never replace newer ones.
     std::vector<double> receive_data();
 
+    /// Receives doubles from the remote host into #data, reusing its
+    /// capacity. Returns the number of doubles received.
+    std::size_t receive_data(std::vector<double>& data);
+
     /// Sends a string message to the remote host
     void send_message(const std::string& message);
 
@@ -64,6 +120,38 @@ public:
     /// Tell whether the MelNet is in blocking or non-blocking mode
     bool is_blocking() const;
 
+    /// Returns the wire Protocol of the MelNet
+    Protocol get_protocol() const;
+
+    /// Returns the number of Framed datagrams that never arrived, judged
+    /// from gaps in the received sequence numbers
+    uint32 get_dropped() const;
+
+    /// Returns the number of Framed datagrams that arrived after a newer one
+    uint32 get_reordered() const;
+
+    /// Returns the number of Framed datagrams received more than once, among
+    /// the last 33 sequence numbers. The repeats are discarded.
+    uint32 get_duplicates() const;
+
+    /// Returns the one-way latency of the last Framed datagram received.
+    /// Only meaningful if both hosts share a clock (e.g. the same machine).
+    Time get_latency() const;
+
+private:
+    /// Writes a Framed datagram of #count elements of #bytes total into
+    /// #buffer_. Returns the datagram size, or 0 if it is too large.
+    std::size_t make_frame(Type type, const void* payload, std::size_t count, std::size_t bytes);
+
+    /// Sends a Framed datagram of #count elements of #bytes total
+    void send_frame(Type type, const void* payload, std::size_t count, std::size_t bytes);
+
+    /// Receives a Framed datagram into #buffer_ and updates the statistics.
+    /// Returns a pointer to its Header, or NULL if nothing valid was received
+    /// or the datagram was a duplicate. #stale is set if it arrived after a
+    /// newer datagram.
+    const Header* receive_frame(bool& stale);
+
 private:
     unsigned short local_port_;  ///< The port to receive data on on the local host
     unsigned short remote_port_;  ///< The port to send data to on the remote host
@@ -73,6 +161,19 @@ private:
     UdpSocket socket_;       ///< The underlying UDP socket
     Packet packet_send_;     ///< The packet used to send data
     Packet packet_receive_;  ///< The packet used to receive data
+
+    Protocol protocol_;         ///< The wire format
+    std::vector<char> buffer_;  ///< Preallocated datagram buffer
+    uint32 sequence_;           ///< Next sequence number to send
+    bool received_;             ///< True once a Framed datagram was received
+    uint32 last_sequence_;      ///< Highest sequence number received
+    uint32 dropped_;            ///< Framed datagrams missing from the sequence
+    uint32 reordered_;          ///< Framed datagrams received after a newer one
+    uint32 duplicates_;         ///< Framed datagrams received more than once
+    uint32 history_;            ///< Which of the 32 sequence numbers before last_sequence_ arrived
+    Time latency_;              ///< One-way latency of the last Framed datagram
+
+    std::vector<UdpSocket::Datagram> destinations_;  ///< Remote host and peers
 };
 
 }  // namespace mel
@@ -82,3 +183,38 @@ private:
 //==============================================================================
 // CLASS DOCUMENTATION
 //==============================================================================
+
+/// \class mel::MelNet
+/// \ingroup Communications
+///
+/// In Raw mode (default), data datagrams are bare arrays of doubles and
+/// messages are Packet strings, as expected by MELScope and the Python and
+/// C# bindings.
+///
+/// In Framed mode, every datagram starts with a MelNet::Header followed by
+/// the payload, copied in and out with a single memcpy each:
+///
+///     [magic][version][type][count][sequence][reserved][timestamp][payload]
+///
+/// The receiver uses the sequence number to count drops, reordering and
+/// duplicates, and the timestamp to measure one-way latency. Duplicates are
+/// discarded. A data datagram that arrives after a newer one is counted but
+/// not returned by receive_data(), since its values are out of date; late
+/// messages and requests are still delivered. Requests are sent as a Request
+/// header instead of the string "request". Datagrams with the wrong magic
+/// or version are ignored. Both ends must use the same Protocol.
+///
+/// To fan the same data out to several hosts, register them with add_peer()
+/// and call broadcast_data(). The datagram is built once and handed to
+/// UdpSocket::send_batch(), which is a single sendmmsg call on Linux.
+///
+/// Usage example:
+/// \code
+/// MelNet melnet(55001, 55002, IpAddress("127.0.0.1"), false, MelNet::Framed);
+/// std::vector<double> data;
+/// while (true) {
+///     if (melnet.receive_data(data) > 0)
+///         print(melnet.get_latency());
+///     ...
+/// }
+/// \endcode
@@ -21,8 +21,10 @@
 #include <MEL/Config.hpp>
 #include <MEL/Communications/SharedMemory.hpp>
 #include <MEL/Core/NonCopyable.hpp>
+#include <MEL/Core/Time.hpp>
 #include <MEL/Core/Types.hpp>
 #include <MEL/Utility/NamedMutex.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -37,8 +39,64 @@ class Packet;
 /// High-level communication class that simplifies shared memory communication
 class MEL_API MelShare : NonCopyable {
 public:
-    /// Default constructor.
-    MelShare(const std::string& name, std::size_t max_bytes = 256);
+    /// The synchronization scheme used to guard the shared memory
+    enum Mode {
+        Locked,   ///< reads and writes are guarded by a NamedMutex
+        LockFree  ///< single writer/multiple reader seqlock, writer never waits
+    };
+
+    /// Read-only view of the doubles in a MelShare. In LockFree mode, the
+    /// View points straight into the memory map without copying and nothing
+    /// is held, so check is_valid() after using the values to make sure the
+    /// writer did not overwrite them in the meantime. In Locked mode, whose
+    /// payload is not 8 byte aligned, the doubles are copied into a buffer
+    /// the MelShare reuses, and the NamedMutex is released at once.
+    class MEL_API View {
+    public:
+        /// Move constructor
+        View(View&& other);
+
+        /// Destructor
+        ~View();
+
+        /// Returns a pointer to the first double
+        const double* data() const;
+
+        /// Returns the number of doubles
+        std::size_t size() const;
+
+        /// Returns the double at #index
+        const double& operator[](std::size_t index) const;
+
+        /// Returns an iterator to the first double
+        const double* begin() const;
+
+        /// Returns an iterator past the last double
+        const double* end() const;
+
+        /// Returns true if the viewed values have not been touched by a
+        /// writer since the View was made (always true in Locked mode)
+        bool is_valid() const;
+
+    private:
+        friend class MelShare;
+
+        /// Constructor. Begins a read of #ms.
+        View(MelShare* ms);
+
+        MelShare* ms_;       ///< The viewed MelShare
+        uint32 seq_;         ///< LockFree sequence when the View was made
+        const double* data_; ///< Pointer into the memory map or the copy
+        std::size_t size_;   ///< Number of doubles
+    };
+
+    /// Default constructor. If #notify is true, writes are counted and
+    /// announced so that readers can block in wait_for_write(). Writers and
+    /// readers must agree on #notify.
+    MelShare(const std::string& name,
+             std::size_t max_bytes = 256,
+             Mode mode = Locked,
+             bool notify = false);
 
     /// Writes a Packet to the MelShare
     void write(Packet& packet);
@@ -49,24 +107,178 @@ public:
     /// Writes a vector of doubles to the MelShare
     void write_data(const std::vector<double>& data);
 
+    /// Writes #size doubles from #data to the MelShare
+    void write_data(const double* data, std::size_t size);
+
     /// Reads a vector of doubles from the MelShare
     std::vector<double> read_data();
 
+    /// Reads the doubles in the MelShare into #data, reusing its capacity.
+    /// Returns the number of doubles read.
+    std::size_t read_data(std::vector<double>& data);
+
+    /// Returns a View of the doubles in the MelShare, without copying them
+    /// in LockFree mode. The View is invalidated by the next view_data().
+    View view_data();
+
     /// Writes a string message to the MelShare
     void write_message(const std::string& message);
 
     /// Reads a string message from the MelShare
     std::string read_message();
 
+    /// Reads a string message from the MelShare into #message, reusing its
+    /// capacity
+    void read_message(std::string& message);
+
+    /// Blocks until there has been a write since the last call returned
+    /// true (or since construction), or until #timeout elapses. Returns true
+    /// if there was a write. Requires notify to be enabled.
+    bool wait_for_write(Time timeout = Time::Inf);
+
+    /// Returns the synchronization Mode of the MelShare
+    Mode get_mode() const;
+
 private:
+    template <typename T>
+    friend class TypedMelShare;
+
     /// Gets the number of bytes currently stored in the MelShare
     uint32 get_size();
 
+    /// Writes #size bytes from #data as a new frame
+    void write_frame(const void* data, uint32 size);
+
+    /// Begins writing a frame. Locks the NamedMutex (Locked) or makes the
+    /// sequence odd (LockFree).
+    void begin_write();
+
+    /// Ends writing a frame. Unlocks the NamedMutex (Locked) or makes the
+    /// sequence even (LockFree).
+    void end_write();
+
+    /// Begins reading a frame and returns its size. Locks the NamedMutex
+    /// (Locked) or waits for an even sequence and stores it in #seq (LockFree).
+    uint32 begin_read(uint32& seq);
+
+    /// Ends reading a frame. Unlocks the NamedMutex and returns true (Locked)
+    /// or returns true if the sequence is still #seq (LockFree).
+    bool end_read(uint32 seq);
+
+    /// Begins a read on construction and ends it on destruction unless
+    /// end() was called, so an exception can't leave the NamedMutex locked
+    class ReadScope : NonCopyable {
+    public:
+        /// Calls begin_read() on #ms
+        ReadScope(MelShare& ms);
+
+        /// Calls end_read() if end() was not called
+        ~ReadScope();
+
+        /// Returns the size of the frame being read
+        uint32 size() const;
+
+        /// Calls end_read() and returns its result
+        bool end();
+
+    private:
+        MelShare& ms_;  ///< The MelShare being read
+        uint32 seq_;    ///< LockFree sequence when the read began
+        uint32 size_;   ///< Frame size
+        bool ended_;    ///< True once end_read() was called
+    };
+
+    /// Returns a pointer to the frame payload in the memory map
+    const char* payload() const;
+
+    /// Returns a writable pointer to the frame payload in the memory map
+    char* payload();
+
+    /// Bumps the write generation and wakes any blocked readers
+    void notify();
+
 private:
-    SharedMemory shm_;  ///< The memory mapped file for the data
-    NamedMutex mutex_;  ///< The mutex guarding the memory map
+    SharedMemory shm_;           ///< The memory mapped file for the data
+    NamedMutex mutex_;           ///< The mutex guarding the memory map
+    Mode mode_;                  ///< The synchronization mode
+    std::size_t offset_;         ///< Byte offset of the frame size from start
+    std::vector<char> scratch_;  ///< Reused frame buffer for LockFree Packets
+    std::vector<double> view_;   ///< Reused copy behind Locked Views
+    std::unique_ptr<SharedMemory> notify_;  ///< Write generation and waiter count
+    uint32 generation_;          ///< Write generation last seen by this reader
 };
 
 }  // namespace mel
 
 #endif  // MEL_MELSHARE_HPP
+
+//==============================================================================
+// CLASS DOCUMENTATION
+//==============================================================================
+
+/// \class mel::MelShare
+/// \ingroup Communications
+///
+/// In Locked mode (default), the memory map is laid out as:
+///
+///     [uint32 size][payload ...]
+///
+/// and every read and write takes a NamedMutex named name + "_mutex". If a
+/// reader such as MELScope is slow to release the mutex, the writer blocks.
+///
+/// In LockFree mode, the memory map is laid out as:
+///
+///     [uint32 sequence][uint32 size][payload ...]
+///
+/// The writer makes the sequence odd, copies the frame, then makes it even
+/// again. It never waits. Readers copy the frame and retry if the sequence
+/// was odd or changed during the copy, i.e. if they caught a torn frame. Only
+/// one process may write to a LockFree MelShare, and all processes must agree
+/// on the Mode of a given MelShare name.
+///
+/// Usage example:
+/// \code
+/// // control loop (writer)
+/// MelShare ms("state", 256, MelShare::LockFree);
+/// ms.write_data({q, qd, tau});
+/// ----------------------------------------------------------------------------
+/// // scope (reader)
+/// MelShare ms("state", 256, MelShare::LockFree);
+/// std::vector<double> state = ms.read_data();
+/// \endcode
+///
+/// On a hot path, avoid the allocation in read_data() by reusing a buffer,
+/// or read the values in place through a View:
+/// \code
+/// std::vector<double> state;
+/// ms.read_data(state); // allocates only if state must grow
+/// ----------------------------------------------------------------------------
+/// double sum;
+/// for (;;) {
+///     MelShare::View view = ms.view_data();
+///     sum = 0;
+///     for (double x : view)
+///         sum += x;
+///     if (view.is_valid()) // only fails in LockFree mode
+///         break;
+/// }
+/// \endcode
+///
+/// Instead of polling, a reader can block until the writer writes again.
+/// This requires both sides to pass notify = true, which keeps a write
+/// generation and a count of blocked readers in a second memory map named
+/// name + "_notify". On Linux, readers sleep on a futex and are woken by
+/// the writer within microseconds. The writer only makes the wake syscall
+/// when a reader is actually blocked. On other platforms, wait_for_write()
+/// polls the generation every millisecond.
+/// \code
+/// MelShare ms("state", 256, MelShare::LockFree, true);
+/// std::vector<double> state;
+/// while (ms.wait_for_write(milliseconds(100)))
+///     ms.read_data(state);
+/// \endcode
+///
+/// The Locked payload starts 4 bytes into the memory map, where doubles
+/// can't be read in place, so a View of a Locked MelShare copies them into
+/// a buffer kept by the MelShare (allocating only when it must grow). Use
+/// LockFree mode, whose payload is 8 byte aligned, for zero copy Views.
@@ -0,0 +1,133 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#ifndef MEL_MELSTREAM_HPP
+#define MEL_MELSTREAM_HPP
+
+#include <MEL/Config.hpp>
+#include <MEL/Communications/SharedMemory.hpp>
+#include <MEL/Core/NonCopyable.hpp>
+#include <MEL/Core/Types.hpp>
+#include <string>
+#include <vector>
+
+namespace mel {
+
+//==============================================================================
+// CLASS DECLARATION
+//==============================================================================
+
+/// Lock-free single producer/single consumer shared memory sample stream
+class MEL_API MelStream : NonCopyable {
+public:
+    /// Default constructor. Creates or opens a MelStream of #slot_count
+    /// samples (rounded up to a power of two), each holding up to #slot_size
+    /// doubles. If the MelStream already exists with a different geometry,
+    /// that geometry is adopted when it fits in the mapped size; otherwise
+    /// the MelStream is invalid.
+    MelStream(const std::string& name,
+              std::size_t slot_count = 1024,
+              std::size_t slot_size = 8);
+
+    /// Pushes one sample to the MelStream (producer only). Returns false if
+    /// the sample is larger than the slot size, or if the MelStream is full,
+    /// in which case an overrun is counted.
+    bool write_data(const std::vector<double>& data);
+
+    /// Pushes one sample of #size doubles to the MelStream (producer only)
+    bool write_data(const double* data, std::size_t size);
+
+    /// Pops the oldest sample into #data (consumer only). Returns false if
+    /// the MelStream is empty.
+    bool read_data(std::vector<double>& data);
+
+    /// Pops all available samples (consumer only)
+    std::vector<std::vector<double>> read_all();
+
+    /// Pops all available samples into #data back to back and returns the
+    /// number of samples read (consumer only). Use when every sample has the
+    /// same size to avoid per-sample allocations.
+    std::size_t read_all(std::vector<double>& data);
+
+    /// Returns the number of samples waiting to be read
+    std::size_t get_available() const;
+
+    /// Returns the total number of samples dropped because the MelStream
+    /// was full when they were written
+    uint32 get_overruns() const;
+
+    /// Returns false if the MelStream was created elsewhere with a geometry
+    /// that does not fit, in which case all reads and writes fail
+    bool is_valid() const;
+
+    /// Returns the number of sample slots
+    std::size_t get_slot_count() const;
+
+    /// Returns the maximum number of doubles per sample
+    std::size_t get_slot_size() const;
+
+private:
+    struct Header;
+
+    /// Returns the Header at the start of the memory map
+    Header* header() const;
+
+    /// Returns a pointer to the beginning of slot #index
+    char* slot(uint32 index) const;
+
+private:
+    SharedMemory shm_;         ///< The memory mapped file for the stream
+    std::size_t slot_count_;   ///< The number of sample slots
+    std::size_t slot_size_;    ///< The maximum number of doubles per slot
+    std::size_t slot_bytes_;   ///< The stride between slots in bytes
+};
+
+}  // namespace mel
+
+#endif  // MEL_MELSTREAM_HPP
+
+//==============================================================================
+// CLASS DOCUMENTATION
+//==============================================================================
+
+/// \class mel::MelStream
+/// \ingroup Communications
+///
+/// Unlike a MelShare, which only holds the latest value, a MelStream keeps
+/// every sample until it is read. The memory map is laid out as a fixed
+/// header followed by #slot_count slots:
+///
+///     [head][tail][overruns][slot_count][slot_size] ... padding ...
+///     [uint32 n][pad][double x n] ... x slot_count
+///
+/// head and tail are free running uint32 sample counters kept on separate
+/// cache lines. Only the producer moves head, and only the consumer moves
+/// tail, so neither side ever takes a lock. When the consumer falls
+/// slot_count samples behind, new samples are dropped and counted in
+/// overruns instead of overwriting unread ones.
+///
+/// Usage example:
+/// \code
+/// // 10 kHz control loop (producer)
+/// MelStream stream("encoders", 4096, 2);
+/// stream.write_data({position, velocity});
+/// ----------------------------------------------------------------------------
+/// // 60 Hz logger (consumer)
+/// MelStream stream("encoders", 4096, 2);
+/// std::vector<double> samples;
+/// std::size_t n = stream.read_all(samples); // 2 * n doubles
+/// \endcode
@@ -60,6 +60,17 @@ public:
     /// Returns the string name of the named memory map
     std::string get_name() const;
 
+    /// Returns the size of the mapped region in bytes
+    std::size_t get_max_bytes() const;
+
+    /// Reads every page of the mapped region so later accesses don't page
+    /// fault. Returns the bytes touched.
+    std::size_t prefault() const;
+
+    /// Calls prefault() on every SharedMemory in the process, including
+    /// those inside MelShares. Returns the bytes touched.
+    static std::size_t prefault_all();
+
 private:
     /// Creates or opens a memory map
     static MapHandle create_or_open(const std::string& name, std::size_t size);
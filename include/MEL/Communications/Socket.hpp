@@ -58,6 +58,7 @@ class UdpSocket;
 class IpAddress;
 class Packet;
 class SocketSelector;
+class EventLoop;
 
 //==============================================================================
 // CLASS DECLARATION
@@ -143,6 +144,7 @@ private:
     friend class IpAddress;
     friend class Packet;
     friend class SocketSelector;
+    friend class EventLoop;
 
     /// Create an internal sockaddr_in address
     static sockaddr_in create_address(uint32 address, unsigned short port);
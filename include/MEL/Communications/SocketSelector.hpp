@@ -140,6 +140,10 @@ private:
 /// \li mel::TcpSocket
 /// \li mel::UdpSocket
 ///
+/// On Linux the selector is backed by epoll: wait() costs O(ready sockets)
+/// rather than O(sockets) and there is no FD_SETSIZE limit on handles.
+/// Other platforms use select().
+///
 /// A selector doesn't store its own copies of the sockets
 /// (socket classes are not copyable anyway), it simply keeps
 /// a reference to the original sockets that you pass to the
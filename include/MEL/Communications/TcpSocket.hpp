@@ -97,8 +97,31 @@ public:
     /// This function will fail if the socket is not connected.
     Status receive(void* data, std::size_t size, std::size_t& received);
 
+    /// Enable or disable the Nagle algorithm (TCP_NODELAY)
+    ///
+    /// No delay is enabled by default, so small packets are sent right
+    /// away instead of being coalesced. The setting is kept across
+    /// connect() and accept().
+    void set_no_delay(bool no_delay);
+
+    /// Tell whether the Nagle algorithm is disabled
+    bool get_no_delay() const;
+
+    /// Set the size of the kernel send buffer (SO_SNDBUF) in bytes
+    ///
+    /// A small buffer bounds how much stale data can queue up behind a
+    /// slow peer; a large one absorbs bursts. 0 keeps the OS default.
+    /// The setting is kept across connect() and accept().
+    void set_send_buffer_size(std::size_t size);
+
+    /// Get the size of the kernel send buffer in bytes, as reported by the
+    /// OS (Linux reports double the requested size), or 0 if not connected
+    std::size_t get_send_buffer_size() const;
+
     /// Send a formatted packet of data to the remote peer
     ///
+    /// The size prefix and the packet data are sent with a single
+    /// scatter-gather call, without copying them into one block.
     /// In non-blocking mode, if this function returns sf::Socket::Partial,
     /// you \em must retry sending the same unmodified packet before sending
     /// anything else in order to guarantee the packet arrives at the remote
@@ -109,24 +132,36 @@ public:
     /// Receive a formatted packet of data from the remote peer
     ///
     /// In blocking mode, this function will wait until the whole packet
-    /// has been received.
+    /// has been received. Data is received straight into an internal
+    /// buffer that is kept between packets.
     /// This function will fail if the socket is not connected.
     Status receive(Packet& packet);
 
 private:
     friend class TcpListener;
 
+    /// Apply the no delay and send buffer settings to the socket
+    void apply_options();
+
+    /// Send two buffers back to back with one scatter-gather call per chunk
+    Status send(const void* first, std::size_t first_size,
+                const void* second, std::size_t second_size,
+                std::size_t& sent);
+
     /// Structure holding the data of a pending packet
     struct PendingPacket {
         PendingPacket();
 
         uint32 Size;               ///< Data of packet size
         std::size_t SizeReceived;  ///< Number of size bytes received so far
-        std::vector<char> Data;    ///< Data of the packet
+        std::size_t DataReceived;  ///< Number of data bytes received so far
+        std::vector<char> Data;    ///< Data of the packet, reused between packets
     };
 
     PendingPacket pending_packet_;  ///< Temporary data of the packet currently
                                     ///< being received
+    bool no_delay_;                 ///< TCP_NODELAY setting
+    std::size_t send_buffer_size_;  ///< SO_SNDBUF setting, 0 for OS default
 };
 
 }  // namespace mel
@@ -0,0 +1,137 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#ifndef MEL_TYPEDMELSHARE_HPP
+#define MEL_TYPEDMELSHARE_HPP
+
+#include <MEL/Communications/MelShare.hpp>
+#include <MEL/Core/NonCopyable.hpp>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace mel {
+
+//==============================================================================
+// CLASS DECLARATION
+//==============================================================================
+
+/// A MelShare holding exactly one trivially copyable T
+template <typename T>
+class TypedMelShare : NonCopyable {
+public:
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 5
+    static_assert(__has_trivial_copy(T), "TypedMelShare<T> requires a trivially copyable T");
+#else
+    static_assert(std::is_trivially_copyable<T>::value, "TypedMelShare<T> requires a trivially copyable T");
+#endif
+    static_assert(sizeof(T) <= 0xFFFFFFFF, "TypedMelShare<T> requires sizeof(T) to fit in a uint32");
+
+    /// Default constructor. The memory map is sized for exactly one T. See
+    /// MelShare for #mode and #notify.
+    TypedMelShare(const std::string& name,
+                  MelShare::Mode mode = MelShare::Locked,
+                  bool notify = false);
+
+    /// Writes #value to the TypedMelShare
+    void write(const T& value);
+
+    /// Reads the value in the TypedMelShare
+    T read();
+
+    /// Reads the value in the TypedMelShare into #value
+    void read(T& value);
+
+    /// Writes only the member #field of the value in the TypedMelShare
+    template <typename F, typename U = T>
+    void write(F U::*field, const F& value);
+
+    /// Reads only the member #field of the value in the TypedMelShare
+    template <typename F, typename U = T>
+    F read(F U::*field);
+
+    /// Reads only element #index of the value in the TypedMelShare, for
+    /// array-like T such as std::array<double, N>. T must store its elements
+    /// contiguously from offset 0. An #index past the end of T asserts in
+    /// debug builds and returns a value initialized element otherwise.
+    template <typename U = T>
+    typename U::value_type operator[](std::size_t index);
+
+    /// Blocks until there has been a write since the last call returned
+    /// true, or until #timeout elapses (see MelShare::wait_for_write)
+    bool wait_for_write(Time timeout = Time::Inf);
+
+private:
+    /// Returns the byte offset of member #field within a T
+    template <typename F, typename U = T>
+    static std::size_t offset_of(F U::*field);
+
+    /// Copies #size bytes at #offset into the value from #data
+    void write_bytes(const void* data, std::size_t size, std::size_t offset);
+
+    /// Copies #size bytes at #offset from the value into #data
+    void read_bytes(void* data, std::size_t size, std::size_t offset);
+
+private:
+    MelShare ms_;  ///< The underlying MelShare
+};
+
+}  // namespace mel
+
+#include <MEL/Communications/Detail/TypedMelShare.inl>
+
+#endif  // MEL_TYPEDMELSHARE_HPP
+
+//==============================================================================
+// CLASS DOCUMENTATION
+//==============================================================================
+
+/// \class mel::TypedMelShare
+/// \ingroup Communications
+///
+/// TypedMelShare<T> lays its memory map out exactly like a MelShare of the
+/// same Mode whose payload is one T, but the size prefix is written once at
+/// construction and every read and write is a single memcpy of sizeof(T)
+/// bytes. There is no per call size check or conversion through vectors.
+/// Because the layout matches, a MelShare of the same Mode (including the
+/// Python and C# bindings and MELScope) can read a TypedMelShare<T> whose T
+/// is made only of doubles with read_data().
+///
+/// Individual members can be read or written by pointer-to-member, and
+/// elements of array-like T can be read with operator[]. Both copy only the
+/// bytes of the member or element.
+///
+/// Usage example:
+/// \code
+/// struct Telemetry {
+///     double position;
+///     double velocity;
+///     double torque;
+/// };
+///
+/// // control loop (writer)
+/// TypedMelShare<Telemetry> ms("telemetry", MelShare::LockFree);
+/// ms.write({q, qd, tau});
+/// ----------------------------------------------------------------------------
+/// // reader
+/// TypedMelShare<Telemetry> ms("telemetry", MelShare::LockFree);
+/// Telemetry t = ms.read();
+/// double q = ms.read(&Telemetry::position);
+/// ----------------------------------------------------------------------------
+/// TypedMelShare<std::array<double, 8>> channels("channels");
+/// double ch3 = channels[3];
+/// \endcode
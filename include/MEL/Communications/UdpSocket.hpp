@@ -47,6 +47,15 @@ public:
                                  ///< sent in a single UDP datagram
     };
 
+    /// One datagram of a batch, pointing at a caller-owned buffer
+    struct Datagram {
+        void* data;              ///< bytes to send, or buffer to receive into
+        std::size_t size;        ///< bytes to send, or capacity of data
+        std::size_t received;    ///< bytes received (receive_batch only)
+        IpAddress address;       ///< destination, or source when received
+        unsigned short port;     ///< destination, or source port when received
+    };
+
     /// Default constructor
     UdpSocket();
 
@@ -107,6 +116,36 @@ public:
                    IpAddress& remote_address,
                    unsigned short& remote_port);
 
+    /// Send a batch of datagrams, each to its own address and port
+    ///
+    /// On Linux the whole batch is handed to the kernel with sendmmsg, so
+    /// sending to many peers costs one syscall per 64 datagrams instead of
+    /// one per datagram. Elsewhere, this falls back to a send() loop.
+    ///
+    /// \param datagrams      Array of datagrams to send
+    /// \param count          Number of datagrams in the array
+    /// \param sent           This variable is filled with the number of
+    /// datagrams sent before the batch completed or an error occured
+    Status send_batch(const Datagram* datagrams,
+                      std::size_t count,
+                      std::size_t& sent);
+
+    /// Receive a batch of datagrams into caller-owned buffers
+    ///
+    /// In blocking mode, this function waits for at least one datagram and
+    /// then takes as many more as are already queued, up to \a count. On
+    /// Linux this uses recvmmsg. Elsewhere, it falls back to a receive()
+    /// loop that stops at the first datagram that is not ready.
+    ///
+    /// \param datagrams      Array of datagrams to fill. Each data/size
+    /// pair must describe a buffer large enough for the expected datagram
+    /// \param count          Number of datagrams in the array
+    /// \param received       This variable is filled with the number of
+    /// datagrams received
+    Status receive_batch(Datagram* datagrams,
+                         std::size_t count,
+                         std::size_t& received);
+
     /// Send a formatted packet of data to a remote peer
     ///
     /// Make sure that the packet size is not greater than
@@ -63,6 +63,20 @@
     #define MEL_API
 #endif
 
+//==============================================================================
+// BRANCH PREDICTION HINTS
+//==============================================================================
+
+// Tell the compiler which way a condition usually goes, so the unlikely code
+// is moved out of the hot path (e.g. logging inside control loops)
+#if defined(__GNUC__) || defined(__clang__)
+    #define MEL_LIKELY(x)   __builtin_expect(!!(x), 1)
+    #define MEL_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+    #define MEL_LIKELY(x)   (x)
+    #define MEL_UNLIKELY(x) (x)
+#endif
+
 // Version of the library
 #define MEL_VERSION_MAJOR 0
 #define MEL_VERSION_MINOR 3
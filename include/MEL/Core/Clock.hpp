@@ -27,8 +27,6 @@
 
 namespace mel {
 
-class Timer;
-
 //==============================================================================
 // CLASS DECLARATION
 //==============================================================================
@@ -45,13 +43,20 @@ public:
     /// Restart the clock back to zero and return elapsed time since started.
     Time restart();
 
-private:
-    friend class Timer;
+    /// Makes all Clocks read the CPU's invariant time stamp counter (x86)
+    /// instead of asking the OS for the time. The first call calibrates the
+    /// counter against CLOCK_MONOTONIC for 100 ms. Returns true if the
+    /// counter is used, or false if #enable is false or the CPU has no
+    /// invariant counter. Best called once at startup.
+    static bool use_tsc(bool enable = true);
 
-    /// Gets the time since epoch. Relative to nothing in particular.
+    /// Gets the current time of the monotonic clock all Clocks read. It is
+    /// relative to an unspecified point (e.g. boot), so times are only
+    /// comparable between processes on the same machine.
     static Time get_current_time();
 
-    Time start_time_;  ///< Time of last reset, in microseconds.
+private:
+    Time start_time_;  ///< Time of last reset, in nanoseconds.
 };
 
 }  // namespace mel
@@ -83,8 +88,15 @@ private:
 /// \endcode
 ///
 /// The mel::Time value returned by the clock can then be
-/// converted to a number of seconds, milliseconds or even
-/// microseconds.
+/// converted to a number of seconds, milliseconds, microseconds
+/// or nanoseconds.
+///
+/// Asking the OS for the time costs tens of nanoseconds, or a
+/// system call on some machines. On x86 CPUs with an invariant
+/// time stamp counter, Clock::use_tsc() makes every Clock read
+/// the counter directly instead, scaled by a rate measured
+/// against the OS clock. The two clocks agree when it is
+/// switched on, so Times taken before and after can be compared.
 ///
 /// \see mel::Time
 
@@ -0,0 +1,187 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+
+#ifndef MEL_EXECUTOR_HPP
+#define MEL_EXECUTOR_HPP
+
+#include <MEL/Config.hpp>
+#include <MEL/Core/Frequency.hpp>
+#include <MEL/Core/Histogram.hpp>
+#include <MEL/Core/NonCopyable.hpp>
+#include <MEL/Core/Time.hpp>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mel {
+
+class Table;
+
+//==============================================================================
+// CLASS DECLARATION
+//==============================================================================
+
+/// Runs periodic tasks at several rates on real-time threads
+class MEL_API Executor : mel::NonCopyable {
+public:
+    /// A periodic task
+    typedef std::function<void()> Task;
+
+    /// Constructor
+    Executor();
+
+    /// Stops the threads if running
+    ~Executor();
+
+    /// Adds a thread pinned to core #cpu (-1 for any core) with SCHED_FIFO
+    /// #priority (-1 to rank threads rate monotonically). Returns its index,
+    /// or -1 if running.
+    std::size_t add_thread(int cpu = -1, int priority = -1);
+
+    /// Adds a #task run every #period on thread #thread and returns its
+    /// index, or -1 if running. Threads up to #thread are added with
+    /// defaults if needed.
+    std::size_t add_task(const std::string& name, Time period, Task task, std::size_t thread = 0);
+
+    /// Adds a #task run at #rate on thread #thread and returns its index
+    std::size_t add_task(const std::string& name, Frequency rate, Task task, std::size_t thread = 0);
+
+    /// Starts one thread per added thread. Returns false if already running
+    /// or there are no tasks.
+    bool start();
+
+    /// Stops and joins the threads after their current tick
+    void stop();
+
+    /// Returns true between start() and stop()
+    bool is_running() const;
+
+    /// Gets the number of tasks added
+    std::size_t get_task_count() const;
+
+    /// Gets the name of task #task
+    const std::string& get_task_name(std::size_t task) const;
+
+    /// Gets the period of task #task, rounded to a multiple of its thread's
+    /// fastest task
+    Time get_task_period(std::size_t task) const;
+
+    /// Gets the Histogram of the run time of each call of task #task, in
+    /// nanoseconds
+    const Histogram& get_execution_time(std::size_t task) const;
+
+    /// Gets the Histogram of the time from each release of task #task (the
+    /// deadline of the tick it runs on) to the end of its call, in nanoseconds
+    const Histogram& get_response_time(std::size_t task) const;
+
+    /// Gets the number of calls of task #task
+    int64 get_run_count(std::size_t task) const;
+
+    /// Gets the number of calls of task #task that ended after its next
+    /// release, i.e. with a response time longer than its period
+    int64 get_overrun_count(std::size_t task) const;
+
+    /// Clears the statistics of all tasks. Call while stopped.
+    void reset_stats();
+
+    /// Gets a Table with one row per task and the columns "period_us",
+    /// "runs", "overruns", "execution_p50_us", "execution_p99_us",
+    /// "execution_max_us", "response_p99_us" and "response_max_us"
+    Table get_stats_table() const;
+
+private:
+    /// A task and its statistics
+    struct TaskInfo {
+        std::string name;         ///< name given to add_task()
+        int64 period_ns;          ///< requested period
+        Task task;                ///< function called
+        std::size_t thread;       ///< index of the thread it runs on
+        int64 divider;            ///< runs every divider ticks of its thread
+        Histogram execution_time; ///< run time of each call
+        Histogram response_time;  ///< release to end of each call
+        int64 runs;               ///< calls
+        int64 overruns;           ///< calls ending after the next release
+    };
+
+    /// A thread and the tasks it runs
+    struct ThreadInfo {
+        int cpu;                          ///< core pinned to, or -1
+        int priority;                     ///< SCHED_FIFO priority, or -1
+        int64 period_ns;                  ///< tick period, the fastest task's
+        std::vector<std::size_t> tasks;   ///< tasks, fastest first
+    };
+
+    /// Assigns tick periods, task dividers and thread priorities
+    void plan();
+
+    /// Runs the tasks of thread #index until stop()
+    void thread_func(std::size_t index);
+
+private:
+    std::vector<TaskInfo> tasks_;      ///< all tasks
+    std::vector<ThreadInfo> threads_;  ///< all threads
+    std::vector<std::thread> workers_; ///< running threads
+    std::atomic<bool> running_;        ///< false to stop the threads
+};
+
+}  // namespace mel
+
+#endif  // MEL_EXECUTOR_HPP
+
+//==============================================================================
+// CLASS DOCUMENTATION
+//==============================================================================
+
+/// \class mel::Executor
+/// \ingroup Core
+///
+/// A control application usually runs loops at several rates, e.g. a 4 kHz
+/// current loop, a 1 kHz impedance loop and a 100 Hz supervisor. Executor
+/// runs each group of tasks on its own thread. The thread ticks with a
+/// Deadline Timer at the rate of its fastest task and calls every task
+/// whose period has come around, fastest (highest rate monotonic priority)
+/// first. Other periods are rounded to a multiple of the fastest one.
+///
+/// Each thread is pinned to a core with set_thread_affinity() and made
+/// real-time with enable_realtime(). Unless given a priority, threads are
+/// ranked rate monotonically: the thread with the fastest tick gets the
+/// highest SCHED_FIFO priority. Threads that can't be made real-time (e.g.
+/// not run as root) log a warning and run at normal priority.
+///
+/// Every call records the task's execution time and response time (from
+/// its release to its end) into Histograms and counts an overrun when the
+/// call ends after the task's next release. Missed ticks are caught up, so
+/// every release is run. The statistics are written by the running threads,
+/// so read them after stop().
+///
+/// Usage example:
+/// \code
+/// Executor executor;
+/// executor.add_thread(2);  // thread 0 on core 2
+/// executor.add_thread(3);  // thread 1 on core 3
+/// executor.add_task("current",   hertz(4000), [&]() { ... }, 0);
+/// executor.add_task("impedance", hertz(1000), [&]() { ... }, 0);
+/// executor.add_task("supervise", hertz(100),  [&]() { ... }, 1);
+/// executor.start();
+/// ...
+/// executor.stop();
+/// print(executor.get_overrun_count(0));
+/// DataLogger::write_to_csv(executor.get_stats_table(), "executor.csv");
+/// \endcode
@@ -0,0 +1,120 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#ifndef MEL_HISTOGRAM_HPP
+#define MEL_HISTOGRAM_HPP
+
+#include <MEL/Config.hpp>
+#include <MEL/Core/Types.hpp>
+#include <string>
+
+namespace mel {
+
+class Table;
+
+//==============================================================================
+// CLASS DECLARATION
+//==============================================================================
+
+/// Fixed size histogram of non-negative integers (e.g. nanoseconds) with
+/// constant relative precision, in the style of an HDR histogram
+class MEL_API Histogram {
+public:
+    /// Values below 2^SUB_BUCKET_BITS are counted exactly; larger values
+    /// fall in buckets 1/2^(SUB_BUCKET_BITS-1) of their magnitude wide (~3%)
+    static const int SUB_BUCKET_BITS = 6;
+
+    /// Largest value told apart; larger values are counted as this one
+    static const int64 MAX_VALUE = (int64(1) << 40) - 1;
+
+    /// Number of buckets
+    static const std::size_t BUCKET_COUNT = 1152;
+
+    /// Constructs an empty Histogram
+    Histogram();
+
+    /// Counts #value. Negative values are counted as 0. Never allocates.
+    void record(int64 value);
+
+    /// Clears all counts
+    void reset();
+
+    /// Returns the number of values recorded
+    uint64 get_count() const;
+
+    /// Returns the smallest value recorded, or 0 if empty
+    int64 get_min() const;
+
+    /// Returns the largest value recorded, or 0 if empty
+    int64 get_max() const;
+
+    /// Returns the mean of the values recorded, or 0 if empty
+    double get_mean() const;
+
+    /// Returns the value that #percentile percent of the recorded values are
+    /// at or below, e.g. get_percentile(99.9). Exact up to the bucket width.
+    int64 get_percentile(double percentile) const;
+
+    /// Returns a Table with one row per non-empty bucket and the columns
+    /// "value" (largest value in the bucket), "count" and "percentile"
+    /// (percent of values at or below it)
+    Table to_table(const std::string& name = "histogram") const;
+
+    /// Returns the bucket #value is counted in
+    static std::size_t bucket_index(int64 value);
+
+    /// Returns the smallest value counted in bucket #index
+    static int64 bucket_lower(std::size_t index);
+
+    /// Returns the largest value counted in bucket #index
+    static int64 bucket_upper(std::size_t index);
+
+private:
+    uint64 counts_[BUCKET_COUNT];  ///< count of each bucket
+    uint64 count_;                 ///< values recorded
+    int64 min_;                    ///< smallest value recorded
+    int64 max_;                    ///< largest value recorded
+    double sum_;                   ///< sum of the values recorded
+};
+
+}  // namespace mel
+
+#endif  // MEL_HISTOGRAM_HPP
+
+//==============================================================================
+// CLASS DOCUMENTATION
+//==============================================================================
+
+/// \class mel::Histogram
+/// \ingroup Core
+///
+/// Each power of two range [2^k, 2^(k+1)) is split into 32 equal buckets, so
+/// a percentile is never off by more than about 3% of its value, from
+/// nanoseconds up to about 18 minutes. All BUCKET_COUNT counters are stored
+/// in the object, so recording is a few integer operations and never
+/// allocates, making it safe inside real-time loops. Timer keeps
+/// Histograms of its wake latency and compute time.
+///
+/// Usage example:
+/// \code
+/// Histogram latency;
+/// ...
+/// latency.record(late_ns);
+/// ...
+/// print(latency.get_percentile(99.9));
+/// DataLogger::write_to_csv(latency.to_table("latency"), "latency.csv");
+/// \endcode
@@ -38,7 +38,8 @@ class Frequency;
 class MEL_API Time {
 public:
     /// Default constructor. Sets time value to zero. To construct valued time
-    /// objects, use mel::seconds, mel::milliseconds or mel::microseconds.
+    /// objects, use mel::seconds, mel::milliseconds, mel::microseconds or
+    /// mel::nanoseconds.
     Time();
 
     /// Overloads stream operator
@@ -53,6 +54,9 @@ public:
     /// Return the time value as a number of microseconds.
     int64 as_microseconds() const;
 
+    /// Return the time value as a number of nanoseconds.
+    int64 as_nanoseconds() const;
+
     /// Returns the reciprocal time as a Frequency
     Frequency to_frequency() const;
 
@@ -64,12 +68,13 @@ private:
     friend MEL_API Time seconds(double);
     friend MEL_API Time milliseconds(int32);
     friend MEL_API Time microseconds(int64);
+    friend MEL_API Time nanoseconds(int64);
 
-    /// Internal constructor from a number of microseconds.
-    explicit Time(int64 microseconds);
+    /// Internal constructor from a number of nanoseconds.
+    explicit Time(int64 nanoseconds);
 
 private:
-    int64 microseconds_;  ///< Time value stored as microseconds
+    int64 nanoseconds_;  ///< Time value stored as nanoseconds
 };
 
 //==============================================================================
@@ -82,9 +87,13 @@ MEL_API Time seconds(double amount);
 /// Construct a time value from a number of milliseconds
 MEL_API Time milliseconds(int32 amount);
 
-/// Construct a time value from a number of microseconds
+/// Construct a time value from a number of microseconds. Values beyond the
+/// +/-292 year range saturate to +/-Time::Inf.
 MEL_API Time microseconds(int64 amount);
 
+/// Construct a time value from a number of nanoseconds
+MEL_API Time nanoseconds(int64 amount);
+
 //==============================================================================
 // OPERATOR OVERLOADS
 //==============================================================================
@@ -178,9 +187,12 @@ MEL_API Time& operator%=(Time& left, Time right);
 ///
 /// mel::Time encapsulates a time value in a flexible way.
 /// It allows to define a time value either as a number of
-/// seconds, milliseconds or microseconds. It also works the
-/// other way round: you can read a time value as either
-/// a number of seconds, milliseconds or microseconds.
+/// seconds, milliseconds, microseconds or nanoseconds. It also
+/// works the other way round: you can read a time value as either
+/// a number of seconds, milliseconds, microseconds or nanoseconds.
+///
+/// Time values are stored as nanoseconds, so they span about
+/// +/- 292 years.
 ///
 /// By using such a flexible interface, the API doesn't
 /// impose any fixed type or resolution for time values,
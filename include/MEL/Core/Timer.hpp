@@ -21,9 +21,12 @@
 #include <MEL/Config.hpp>
 #include <MEL/Core/Clock.hpp>
 #include <MEL/Core/Frequency.hpp>
+#include <MEL/Core/Histogram.hpp>
 
 namespace mel {
 
+class Table;
+
 //==============================================================================
 // CLASS DECLARATION
 //==============================================================================
@@ -40,11 +43,20 @@ public:
     /// use Busy. On real-time Linux, threads can sleep for much smaller
     /// periods, so Sleep and Hybrid can be used reliably. Generally, using
     /// Hybrid over Sleep will be more accurate since Sleep can go over the
-    /// requested sleep period.
+    /// requested sleep period. Deadline is the best choice on Linux: it
+    /// keeps the exact long-term rate and sleeps nearly the whole period.
     enum WaitMode {
         Busy,     ///< Waits 100% remaining time using a busy while loop
         Sleep,    ///< Waits 100% remaining time by sleeping the thread
-        Hybrid    ///< Waits 90% remaining time using Sleep, then 10% using Busy
+        Hybrid,   ///< Waits 90% remaining time using Sleep, then 10% using Busy
+        Deadline  ///< Sleeps until start + ticks * period, then spins any spin time
+    };
+
+    /// What a Deadline Timer does when wait() is called after a deadline
+    /// has already passed
+    enum MissPolicy {
+        CatchUp,  ///< Returns at once for each missed tick until back on schedule
+        Skip      ///< Waits for the next deadline still ahead, counting the missed ticks
     };
 
 public:
@@ -70,6 +82,15 @@ public:
     /// Gets the actual elapsed time since construction or last call to restart().
     Time get_elapsed_time_actual();
 
+    /// Gets the deadline the current tick started at, i.e. the time the last
+    /// wait() was due to return, or the start time before the first wait().
+    /// It is on the clock of get_monotonic_time(), not that of Clock.
+    Time get_tick_deadline() const;
+
+    /// Gets the current time on the clock Timer deadlines are kept on, to
+    /// compare with get_tick_deadline()
+    static Time get_monotonic_time();
+
     /// Gets the elapsed number of ticks since construction or the last call to
     /// restart().
     int64 get_elapsed_ticks();
@@ -80,12 +101,54 @@ public:
     /// Gets the Timer period
     Time get_period();
 
+    /// Sets what a Deadline Timer does after missing deadlines (default CatchUp)
+    void set_miss_policy(MissPolicy policy);
+
+    /// Sets the longest a Deadline Timer busy waits before each deadline
+    /// (default Zero). The time actually spun is calibrated to how late the
+    /// thread has been waking up from sleep, up to #max_spin.
+    void set_spin_time(Time max_spin);
+
+    /// Gets the Histogram of how late each wait() returned after its tick's
+    /// deadline, in nanoseconds
+    const Histogram& get_wake_latency() const;
+
+    /// Gets the Histogram of the time from each tick's start (the return of
+    /// the previous wait()) to the call of wait(), in nanoseconds
+    const Histogram& get_compute_time() const;
+
+    /// Gets the number of deadlines already passed when wait() was called
+    int64 get_overrun_count() const;
+
+    /// Clears the wake latency and compute time Histograms and overrun count
+    void reset_stats();
+
+    /// Gets a Table of the 50, 90, 99, 99.9, 99.99 and 100th percentiles
+    /// (column "percentile") of wake latency and compute time in microseconds
+    /// (columns "wake_latency_us" and "compute_time_us"), e.g. to save with
+    /// DataLogger::write_to_csv()
+    Table get_stats_table() const;
+
+protected:
+    /// Waits until the next absolute deadline and returns it. #now is the
+    /// time wait() was called.
+    int64 wait_deadline(int64 now);
+
 protected:
     WaitMode mode_;   ///< The Timer's waiting mode
     Clock clock_;     ///< The Timer's internal clock
     Time period_;     ///< The Timer's waiting period
     int64 ticks_;     ///< The running tick count
     Time prev_time_;  ///< Time saved at previous call to wait or restart
+    MissPolicy miss_policy_;  ///< Deadline behavior after a missed deadline
+    int64 start_ns_;          ///< Deadline schedule start, monotonic nanoseconds
+    int64 max_spin_ns_;       ///< longest busy wait before a deadline
+    int64 wake_latency_ns_;   ///< recent lateness waking from sleep
+    int64 tick_start_ns_;     ///< time the previous wait() or restart() returned
+    int64 tick_deadline_ns_;  ///< deadline the previous wait() was due to return at
+    int64 overruns_;          ///< deadlines missed
+    Histogram wake_latency_;  ///< return of wait() minus the deadline
+    Histogram compute_time_;  ///< call of wait() minus the tick start
 };
 
 }  // namespace mel
@@ -110,12 +173,32 @@ protected:
 /// option, but frees the CPU to the operating system for the entire wait
 /// period. Use Sleep when accuracy is not critical. Hybrid combines the best of
 /// both, Sleeping for the first 90% of the remaining wait time and Busy waiting
-/// for the last 10%. Prefer Hybrid wait on real-time Linux operating systems.
+/// for the last 10%.
+///
+/// Each of those modes measures the period from the moment the previous
+/// wait() returned, so any lateness waking up accumulates into drift. The
+/// Deadline mode instead waits for absolute deadlines at start + k * period.
+/// On Linux it sleeps with clock_nanosleep(TIMER_ABSTIME), so a late wakeup
+/// delays only that tick, and a 1 kHz loop runs at exactly 1 kHz in the
+/// long run. set_spin_time() adds a short busy wait before each deadline to
+/// hide the wakeup latency, calibrated to the latency actually observed.
+/// set_miss_policy() chooses whether missed ticks are caught up or skipped.
+/// Prefer Deadline on real-time Linux operating systems.
+///
+/// Every wait() records how late it returned after its deadline and how long
+/// the loop body ran before calling it into two fixed size Histograms, so a
+/// loop's jitter can be checked (e.g. get_wake_latency().get_percentile(99.9))
+/// without external tools. Recording never allocates. Call reset_stats()
+/// after warm up, and get_stats_table() to save a summary. The two
+/// Histograms are stored in the Timer, which adds about 18 KB to each one,
+/// so prefer reusing a Timer over creating one per loop iteration.
 ///
 /// Usage example:
 /// \code
-/// // create a 1000 Hz timer that uses a Busy waiting mode
-/// mel::Timer my_timer(mel::milliseconds(1), Timer::WaitMode::Busy);
+/// // create a 1000 Hz timer that sleeps until each deadline, spinning at most
+/// // 50 us at the end
+/// mel::Timer my_timer(mel::milliseconds(1), Timer::Deadline);
+/// my_timer.set_spin_time(mel::microseconds(50));
 /// while(condition) {
 ///     // code that executes in less that 1 ms
 ///     ...
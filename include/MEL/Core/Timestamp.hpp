@@ -12,6 +12,9 @@ public:
     /// Default constructor
     Timestamp();
 
+    /// Constructs the local time #microseconds after the Unix epoch
+    explicit Timestamp(long long microseconds);
+
     /// Returns timestamp string as "yyyy-mm-dd"
     std::string yyyy_mm_dd() const;
 
@@ -20,9 +20,12 @@
 
 #include <MEL/Config.hpp>
 #include <MEL/Logging/File.hpp>
+#include <MEL/Logging/MappedFile.hpp>
 #include <MEL/Utility/Mutex.hpp>
 #include <MEL/Logging/Table.hpp>
+#include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace mel {
@@ -30,6 +33,8 @@ namespace mel {
 enum class WriterType {
     Buffered  = 0,  ///< stores data to write to file all at once later
     Immediate = 1,  ///< writes immediately to open file
+    Streaming = 2,  ///< copies into a preallocated arena that a background
+                    ///< thread streams to the open file (real-time safe)
 };
 
 enum class DataFormat {
@@ -38,6 +43,12 @@ enum class DataFormat {
     Scientific  ///< values are written with scientific notion
 };
 
+enum class FileFormat {
+    Csv,       ///< comma separated text
+    Binary64,  ///< MEL binary log of float64 values
+    Binary32   ///< MEL binary log of float32 values (half the size)
+};
+
 
 //==============================================================================
 // CLASS DECLARATION
@@ -67,6 +78,15 @@ public:
 	/// Read a vector of Tables from a file
 	static bool read_from_csv(std::vector<Table> &data, const std::string &filename, const std::string& directory = ".");
 
+	/// Write a Table to a MEL binary log file
+	static bool write_to_bin(const Table &data, const std::string &filename = "", const std::string& directory = ".", bool timestamp = true, FileFormat format = FileFormat::Binary64);
+
+	/// Read a Table from a MEL binary log file, which is memory mapped rather than parsed
+	static bool read_from_bin(Table &data, const std::string &filename, const std::string& directory = ".");
+
+	/// Convert a MEL binary log file to a csv file with a header row of column names
+	static bool bin_to_csv(const std::string &bin_filename, const std::string &csv_filename = "", const std::string& directory = ".");
+
 	static std::string make_csv_header(const Table &table);
 
 	static bool parse_csv_header(Table &table, const std::string &header);
@@ -83,9 +103,15 @@ public:
     ~DataLogger();
 
     /// Store data record in a buffer to be written to a file later using
-    /// save_data().
+    /// save_data(). With WriterType::Streaming, the record is instead copied
+    /// into the arena and written in the background to the open() file.
     void buffer(const std::vector<double>& data_record);
 
+    /// Store #size values from #data_record, as above. With
+    /// WriterType::Streaming this never locks or allocates, so it is safe to
+    /// call from a real-time loop.
+    void buffer(const double* data_record, std::size_t size);
+
     /// Writes buffered data to the to the specified filename and directory.
     void save_data(const std::string& filename,
                    const std::string& directory = ".",
@@ -94,7 +120,8 @@ public:
     /// Clears all buffered data, but keeps the the column header names.
     void clear_data();
 
-    /// Saves all data collected so far, the clears all data.
+    /// Saves all data collected so far, the clears all data. The rows are
+    /// moved to the saving thread instead of copied.
     void save_and_clear_data(std::string filename,
                              std::string directory = ".",
                              bool timestamp        = true);
@@ -103,8 +130,9 @@ public:
     /// has completed.
     void wait_for_save();
 
-    /// Write data record immediately to file (opens file if not already open),
-    /// with no guarantee of execution time (generally 10s of us).
+    /// Write data record immediately to file (opens file if not already open).
+    /// The row is copied into a memory mapped file, generally taking under a
+    /// microsecond for binary files, plus formatting for csv files.
     void write(const std::vector<double>& data_record);
 
     /// Open the file for an Immediate writer type, clearing what is currently
@@ -119,9 +147,20 @@ public:
                 const std::string& directory = ".",
                 bool timestamp               = true);
 
-    /// Close the file for an Immediate writer type.
+    /// Close the file for an Immediate writer type. For a Streaming writer
+    /// type, first waits for all buffered rows to be written.
     void close();
 
+    /// Set the arena of a Streaming writer type, which is allocated by open():
+    /// #chunk_count chunks of #chunk_rows rows each. A chunk is handed to the
+    /// background writer when full, so the arena should hold well over the
+    /// rows logged while the disk stalls. Must be called before open().
+    void set_stream_capacity(std::size_t chunk_rows, std::size_t chunk_count);
+
+    /// Get the number of rows a Streaming writer type dropped because the
+    /// background writer fell a full arena behind.
+    std::size_t get_dropped_rows() const;
+
     /// Set whether the file will be written to immediately or buffered
     void set_writer_type(WriterType writer_type);
 
@@ -131,6 +170,10 @@ public:
     /// Set the data format and precision for every row of the data log
     void set_record_format(DataFormat data_format, std::size_t precision);
 
+    /// Set whether files are written as csv text (default) or as a MEL
+    /// binary log, which is smaller and much faster to write and read back
+    void set_file_format(FileFormat file_format);
+
     /// Get the number of rows currently in the data buffer
     std::size_t get_row_count() const;
 
@@ -144,14 +187,25 @@ public:
     std::vector<double> get_col(std::size_t col);
 
 private:
-    /// Writes the current header to the file
-    void write_header();
+    /// Writes the current header to the file. A binary header describes
+    /// #col_count columns, named from the header row where given.
+    void write_header(std::size_t col_count);
 
     /// Converts a data record to a csv string with the specified formatting,
-    /// i.e. format, precission
+    /// i.e. format, precission, or to binary for a binary FileFormat
     std::string format(const std::vector<double>& data_record);
 
-    /// Function called by saving thread
+    /// Converts #size values of a data record to a string, as above
+    std::string format(const double* data_record, std::size_t size);
+
+    /// Builds the file name and starts a saving thread that takes #data
+    void save(const std::string& filename,
+              const std::string& directory,
+              bool timestamp,
+              std::vector<std::vector<double>> data);
+
+    /// Function called by saving thread. Rows are formatted in fixed size
+    /// chunks and freed as they are written.
     void save_thread_func(const std::string& full_filename,
                           const std::string& directory,
                           std::vector<std::vector<double>> temp_data);
@@ -159,14 +213,24 @@ private:
     /// Doubles the number of reserved rows in data_
     void double_rows();
 
+    /// Allocates the Streaming arena and starts the writer thread
+    void start_stream();
+
+    /// Hands the chunk being filled to the Streaming writer thread
+    void publish_chunk();
+
+    /// Function called by the Streaming writer thread
+    void stream_thread_func();
+
 private:
     WriterType writer_type_;///< stores whether writer is Immeadiate or Buffered
     Mutex mutex_;           ///< handles multi-threading
-    File file_;             ///< File to which data will be written
+    MappedFile file_;       ///< File to which data will be written
     off_t file_size_;       ///< size of file_ since last open or write
     std::string file_ext_;  ///< file extension
     std::string filename_no_ext_;  ///< filename without extension
     bool file_opened_;             ///< true when file_ is open
+    std::string row_text_;         ///< reused text of an Immediate row
     std::vector<std::vector<double>>  data_buffer_;  ///< storage container for log data
     bool autosave_;    ///< when true automatically saves the data log to a file upon destruction
 
@@ -176,8 +240,22 @@ private:
     std::size_t max_rows_;   ///< number of rows reserved in the data buffer
     std::size_t row_count_;  ///< number of rows currently written to the data logger
     std::size_t col_count_;  ///< number of columns in the header
+    std::size_t bin_col_count_; ///< values per binary row, as in the file's header
     DataFormat  format_;     ///< the floating point number format the DataLog will be saved with
     std::size_t precision_;  ///< the floating point number precision the DataLog will be saved with
+    FileFormat file_format_; ///< csv or binary
+
+    std::vector<double> arena_;             ///< Streaming rows, chunk_count_ x chunk_rows_ x col_count_
+    std::vector<std::size_t> chunk_fill_;   ///< rows in each published chunk
+    std::size_t chunk_rows_;                ///< rows per arena chunk
+    std::size_t chunk_count_;               ///< chunks in the arena
+    std::size_t chunk_;                     ///< chunk being filled (free running)
+    std::size_t chunk_row_;                 ///< next row in the chunk being filled
+    std::atomic<std::size_t> dropped_rows_; ///< rows lost to a full arena
+    std::atomic<std::size_t> published_;    ///< chunks handed to the writer thread
+    std::atomic<std::size_t> consumed_;     ///< chunks written by the writer thread
+    std::atomic<bool> streaming_;           ///< true while the writer thread runs
+    std::thread stream_thread_;             ///< Streaming writer thread
 };
 
 }  // namespace mel
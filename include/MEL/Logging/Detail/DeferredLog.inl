@@ -0,0 +1,113 @@
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace mel {
+
+namespace detail {
+
+/// Type tags of arguments encoded by DeferredLog
+enum DeferredArg {
+    DeferredInt    = 1,  ///< int64
+    DeferredUInt   = 2,  ///< uint64
+    DeferredDouble = 3,  ///< double
+    DeferredBool   = 4,  ///< one byte, 0 or 1
+    DeferredChar   = 5,  ///< one char
+    DeferredString = 6   ///< uint16 length followed by the chars
+};
+
+/// Appends tagged arguments to a slot until it is full
+struct DeferredEncoder {
+    char* pos;
+    char* end;
+
+    void put(DeferredArg type, const void* data, std::size_t size) {
+        if (pos + 1 + size > end) {
+            pos = end;  // later arguments are dropped too, keeping them in order
+            return;
+        }
+        *pos++ = static_cast<char>(type);
+        std::memcpy(pos, data, size);
+        pos += size;
+    }
+
+    void put_string(const char* str, std::size_t length) {
+        if (pos + 1 + sizeof(uint16) > end) {
+            pos = end;
+            return;
+        }
+        std::size_t room = static_cast<std::size_t>(end - pos) - 1 - sizeof(uint16);
+        uint16 n = static_cast<uint16>(length < room ? length : room);
+        *pos++ = static_cast<char>(DeferredString);
+        std::memcpy(pos, &n, sizeof(n));
+        std::memcpy(pos + sizeof(n), str, n);
+        pos += sizeof(n) + n;
+    }
+};
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+encode_deferred(DeferredEncoder& enc, const T& value) {
+    int64 v = value;
+    enc.put(DeferredInt, &v, sizeof(v));
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+encode_deferred(DeferredEncoder& enc, const T& value) {
+    uint64 v = value;
+    enc.put(DeferredUInt, &v, sizeof(v));
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_enum<T>::value>::type
+encode_deferred(DeferredEncoder& enc, const T& value) {
+    int64 v = static_cast<int64>(value);
+    enc.put(DeferredInt, &v, sizeof(v));
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value>::type
+encode_deferred(DeferredEncoder& enc, const T& value) {
+    double v = static_cast<double>(value);
+    enc.put(DeferredDouble, &v, sizeof(v));
+}
+
+inline void encode_deferred(DeferredEncoder& enc, const bool& value) {
+    char v = value ? 1 : 0;
+    enc.put(DeferredBool, &v, 1);
+}
+
+inline void encode_deferred(DeferredEncoder& enc, const char& value) {
+    enc.put(DeferredChar, &value, 1);
+}
+
+inline void encode_deferred(DeferredEncoder& enc, const char* value) {
+    value = value ? value : "(null)";
+    enc.put_string(value, std::strlen(value));
+}
+
+template <std::size_t N>
+inline void encode_deferred(DeferredEncoder& enc, const char (&value)[N]) {
+    enc.put_string(value, std::strlen(value));
+}
+
+inline void encode_deferred(DeferredEncoder& enc, const std::string& value) {
+    enc.put_string(value.data(), value.size());
+}
+
+}  // namespace detail
+
+template <typename... Args>
+void DeferredLog::write(const LogSite& site, const Args&... args) {
+    std::size_t pos;
+    Slot* slot = claim(site, pos);
+    if (!slot)
+        return;
+    detail::DeferredEncoder enc = {slot->args, slot->args + ARG_BYTES};
+    int expand[] = {0, (detail::encode_deferred(enc, args), 0)...};
+    (void)expand;
+    publish(slot, pos, static_cast<std::size_t>(enc.pos - slot->args));
+}
+
+}  // namespace mel
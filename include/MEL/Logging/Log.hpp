@@ -21,6 +21,7 @@
 #include <MEL/Config.hpp>
 #include <MEL/Logging/Formatters/CsvFormatter.hpp>
 #include <MEL/Logging/Formatters/TxtFormatter.hpp>
+#include <MEL/Logging/Writers/AsyncWriter.hpp>
 #include <MEL/Logging/Writers/ColorConsoleWriter.hpp>
 #include <MEL/Logging/Writers/RollingFileWriter.hpp>
 #include <MEL/Logging/Writers/Writer.hpp>
@@ -46,6 +47,16 @@
 #define LOG_GET_FILE() ""
 #endif
 
+/// Least severe level compiled in. LOG sites less severe than it are removed
+/// at compile time, e.g. -DMEL_LOG_MAX_SEVERITY=Info strips LOG(Verbose) and
+/// LOG(Debug). Set for MEL itself with the LOG_MAX_SEVERITY CMake option.
+#ifndef MEL_LOG_MAX_SEVERITY
+#define MEL_LOG_MAX_SEVERITY Debug
+#endif
+
+/// True if LOG sites of #severity are compiled in
+#define LOG_ENABLED(severity) ((severity) <= ::mel::MEL_LOG_MAX_SEVERITY)
+
 namespace mel {
 
 //==============================================================================
@@ -149,7 +160,9 @@ inline Logger<instance>& init_logger(Severity max_severity,
 /// Built in MEL Logger. Contains two writers: (0) a RollingFileWriter with a
 /// TxtFormatter and default severity Verbose, and (1) a ColorConsoleWriter with
 /// TxtFormatter and defaultl severity Info. Can be disabled by defining
-/// MEL_DISABLE_LOG or enabling DISABLE_LOG option in CMakeLists.txt
+/// MEL_DISABLE_LOG or enabling DISABLE_LOG option in CMakeLists.txt. With
+/// MEL_ASYNC_LOG (the ASYNC_LOG option) the file is written through an
+/// AsyncWriter, so logging never blocks the calling thread on disk I/O.
 extern MEL_API Logger<DEFAULT_LOGGER>* MEL_LOGGER;
 
 }  // namespace mel
@@ -158,11 +171,14 @@ extern MEL_API Logger<DEFAULT_LOGGER>* MEL_LOGGER;
 // LOGGING MACRO FUNCTIONS
 //==============================================================================
 
-/// Log severity level checker for specific logger instance
-#define IF_LOG_(instance, severity)                          \
-    if (!get_logger<instance>() ||                           \
-        !get_logger<instance>()->check_severity(severity)) { \
-        ;                                                    \
+/// Log severity level checker for specific logger instance. Sites removed by
+/// MEL_LOG_MAX_SEVERITY fold to nothing, and the branch to enabled sites is
+/// laid out as unlikely.
+#define IF_LOG_(instance, severity)                                      \
+    if (!LOG_ENABLED(severity) ||                                        \
+        MEL_LIKELY(!get_logger<instance>() ||                            \
+                   !get_logger<instance>()->check_severity(severity))) { \
+        ;                                                                \
     } else
 
 /// Main logging macro for specific logger instance
@@ -171,16 +187,17 @@ extern MEL_API Logger<DEFAULT_LOGGER>* MEL_LOGGER;
     (*get_logger<instance>()) += Record(severity, LOG_GET_FUNC(), __LINE__, LOG_GET_FILE())
 
 /// Conditional logging macro for specific logger instance
-#define LOG_IF_(instance, severity, condition) \
-    if (!(condition)) {                        \
-        ;                                      \
-    } else                                     \
+#define LOG_IF_(instance, severity, condition)    \
+    if (!LOG_ENABLED(severity) || !(condition)) { \
+        ;                                         \
+    } else                                        \
         LOG_(instance, severity)
 
 /// Log severity level checker for default MEL logger
-#define IF_LOG(severity)                                        \
-    if (!MEL_LOGGER || !MEL_LOGGER->check_severity(severity)) { \
-        ;                                                       \
+#define IF_LOG(severity)                                                   \
+    if (!LOG_ENABLED(severity) ||                                          \
+        MEL_LIKELY(!MEL_LOGGER || !MEL_LOGGER->check_severity(severity))) { \
+        ;                                                                  \
     } else
 
 /// Main logging macro for defaulter MEL logger
@@ -189,10 +206,10 @@ extern MEL_API Logger<DEFAULT_LOGGER>* MEL_LOGGER;
         *MEL_LOGGER += Record(severity, LOG_GET_FUNC(), __LINE__, LOG_GET_FILE())
 
 /// Conditional logging macro for default MEL logger
-#define LOG_IF(severity, condition) \
-    if (!(condition)) {             \
-        ;                           \
-    } else                          \
+#define LOG_IF(severity, condition)               \
+    if (!LOG_ENABLED(severity) || !(condition)) { \
+        ;                                         \
+    } else                                        \
         LOG(severity)
 
 #endif  // MEL_LOG_HPP
@@ -0,0 +1,157 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#ifndef MEL_MAPPEDFILE_HPP
+#define MEL_MAPPEDFILE_HPP
+
+#include <MEL/Config.hpp>
+#include <MEL/Core/NonCopyable.hpp>
+#include <MEL/Core/Time.hpp>
+#include <MEL/Logging/File.hpp>
+#include <MEL/Utility/Mutex.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mel {
+
+//==============================================================================
+// CLASS DECLARATION
+//==============================================================================
+
+/// Append-only file written through a growing shared memory map, with the
+/// same interface as File
+class MEL_API MappedFile : mel::NonCopyable {
+public:
+    /// Bytes preallocated past the end of the file when it is opened. Each
+    /// time the region fills up it is doubled, by at most MAX_GROW_BYTES.
+    static const std::size_t GROW_BYTES = 1 << 20;
+
+    /// Largest single growth of the mapped region
+    static const std::size_t MAX_GROW_BYTES = 64 << 20;
+
+    /// set_length_field() offset meaning no length field
+    static const std::size_t NO_LENGTH_FIELD = static_cast<std::size_t>(-1);
+
+    /// Constructor. Written bytes are flushed to disk every #sync_period.
+    MappedFile(Time sync_period = milliseconds(100));
+
+    /// Closes the file if it is open
+    ~MappedFile();
+
+    /// Opens the file for appending and returns its size. If #length is not
+    /// negative, the file is first truncated to #length bytes, e.g. to drop
+    /// the zero tail a MappedFile that was never closed leaves after its data.
+    off_t open(const char* fileName, off_t length = -1);
+
+    /// Appends to the file if it is open. Returns the bytes written, or -1
+    /// if the file is closed or its space can't be reserved (e.g. disk full).
+    int write(const void* buf, size_t count);
+
+    /// Appends to the file if it is open
+    template <class CharType>
+    int write(const std::basic_string<CharType>& str) {
+        return write(str.data(), str.size() * sizeof(CharType));
+    }
+
+    /// Blocks until everything written so far is on disk
+    void sync();
+
+    /// Keeps the committed length of the file, as a uint64 at byte #offset,
+    /// up to date once the file is that long: sync() stores the length of the
+    /// bytes it flushed, and close() the final length. Cleared by close().
+    void set_length_field(std::size_t offset);
+
+    /// Truncates the file to the bytes written and closes it
+    void close();
+
+private:
+    /// A mapping replaced by grow(), unmapped later by the sync thread
+    struct Mapping {
+        char* data;
+        std::size_t capacity;
+    };
+
+    /// Grows the file and its mapping to hold at least #size bytes
+    bool grow(std::size_t size);
+
+    /// Stops the sync thread, unmaps everything and closes the descriptor
+    void release();
+
+    /// Writes #size to the length field through the descriptor, if it is set
+    /// and the file is long enough to hold it
+    void store_length(std::size_t size);
+
+    /// Background thread function
+    void sync_thread_func();
+
+private:
+    Time sync_period_;                  ///< time between background syncs
+    int fd_;                            ///< descriptor, or -1 when closed
+    File file_;                         ///< used when the file can't be mapped
+    char* data_;                        ///< start of the mapping
+    std::size_t capacity_;              ///< bytes mapped
+    std::atomic<std::size_t> size_;     ///< bytes written
+    std::size_t synced_;                ///< bytes flushed by sync()
+    std::atomic<std::size_t> length_field_; ///< offset of the committed length
+    bool out_of_space_;                 ///< grow() failed, logged once
+    Mutex mutex_;                       ///< guards the mapping against sync()
+    Mutex sync_mutex_;                  ///< one sync() at a time
+    std::vector<Mapping> retired_;      ///< mappings left for the sync thread
+    std::mutex wake_mutex_;             ///< guards running_
+    std::condition_variable wake_;      ///< wakes the sync thread to stop
+    bool running_;                      ///< false to stop the sync thread
+    std::thread thread_;                ///< background sync thread
+};
+
+}  // namespace mel
+
+#endif  // MEL_MAPPEDFILE_HPP
+
+//==============================================================================
+// CLASS DOCUMENTATION
+//==============================================================================
+
+/// \class mel::MappedFile
+/// \ingroup Logging
+///
+/// File::write() makes a write() system call, which can take tens of
+/// microseconds. A MappedFile preallocates space with fallocate() and maps
+/// it with MAP_SHARED, so a write() is a memcpy into the page cache. When
+/// the region fills up, the writing thread extends the file and maps it
+/// again. A background thread flushes the new bytes with msync() every sync
+/// period. It also unmaps the replaced regions, so the writer never waits
+/// on the disk. close() truncates the file to the bytes actually written.
+/// If fallocate() fails for lack of space, write() fails and logs an error,
+/// rather than mapping a sparse file whose first store would raise SIGBUS
+/// once the disk is full. Only file systems without fallocate() support
+/// fall back to a sparse ftruncate().
+///
+/// The pages belong to the file, not the process, so written bytes survive
+/// a crash of the program; those older than one sync period also survive a
+/// crash of the OS. Because close() never ran, the file then keeps its
+/// preallocated size, with zero bytes after the data. Zero bytes can be data
+/// too, so the end of the data isn't guessed from the contents: a format
+/// with a header can reserve a uint64 for set_length_field(), which holds
+/// the length last flushed by sync(). Passing it to open() drops the tail,
+/// along with any bytes written in the last sync period before the crash.
+///
+/// Writes must come from one thread at a time. When the file can't be
+/// mapped, and on Windows, writes go straight to the file as with File.
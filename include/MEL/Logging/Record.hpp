@@ -105,6 +105,15 @@ public:
            const char* file,
            Timestamp timestamp = Timestamp());
 
+    /// Constructor for a Record made earlier on thread #tid, e.g. when a
+    /// queued Record is written by a background thread
+    Record(Severity severity,
+           const char* func,
+           size_t line,
+           const char* file,
+           Timestamp timestamp,
+           unsigned int tid);
+
     /// Destructor
     virtual ~Record();
 
@@ -138,6 +147,9 @@ public:
     /// Gets the name of the function in which the Record was made
     virtual const char* get_func() const;
 
+    /// Gets the function name exactly as captured, without processing
+    virtual const char* get_raw_func() const;
+
     /// Gets the name of the file in which the Record was made
     virtual const char* get_file() const;
 
@@ -24,10 +24,34 @@
 
 namespace mel{
 
+/// Named columns of doubles, stored column-major in one contiguous buffer
 class MEL_API Table {
 public:
 	static const std::string table_id;
 
+	/// Read only view of one column. It copies nothing and stays valid until
+	/// the Table is next modified.
+	class Column {
+	public:
+		Column(const double* data, std::size_t size) : data_(data), size_(size) {}
+
+		const double* data() const { return data_; }
+
+		std::size_t size() const { return size_; }
+
+		bool empty() const { return size_ == 0; }
+
+		const double& operator[](std::size_t index) const { return data_[index]; }
+
+		const double* begin() const { return data_; }
+
+		const double* end() const { return data_ + size_; }
+
+	private:
+		const double* data_;
+		std::size_t size_;
+	};
+
 public:
 	/// Constructor
 	Table(const std::string &name = "", const std::vector<std::string> &col_names = std::vector<std::string>(), const std::vector<std::vector<double>> &values = std::vector<std::vector<double>>());
@@ -67,16 +91,26 @@ public:
 	/// Read access in 2D
 	const double &operator()(std::size_t row_index, std::size_t col_index) const;
 
-	/// Read access to rows
-	const std::vector<double> &operator()(std::size_t row_index) const;
+	/// Read access to rows, copied out of the columns
+	std::vector<double> operator()(std::size_t row_index) const;
 
-	/// Read access to all values
-	const std::vector<std::vector<double>> &values() const;
+	/// Copy of all values, row by row
+	std::vector<std::vector<double>> values() const;
 
 	std::vector<double> get_row(std::size_t index) const;
 
+	/// Copies a row into #row, reusing its memory
+	bool get_row(std::size_t index, std::vector<double> &row) const;
+
 	std::vector<double> get_col(std::size_t index) const;
 
+	/// Zero copy view of a column
+	Column col(std::size_t index) const;
+
+	/// Allocates room for #rows rows so that appending them does not move
+	/// the stored values
+	void reserve(std::size_t rows);
+
 	void pop_back_row();
 
 	bool erase_row(std::size_t index);
@@ -106,14 +140,24 @@ private:
 
 	bool check_inner_dim(const std::vector<std::vector<double>> &values, std::size_t row_size) const;
 
+	/// Makes room to append #count rows, growing in large blocks
+	void grow_rows(std::size_t count);
+
+	/// Returns the first value of a column
+	double *col_data(std::size_t index);
+
+	/// Returns the first value of a column
+	const double *col_data(std::size_t index) const;
+
 private:
 	std::string name_;
 
 	std::size_t n_cols_;
 	std::size_t n_rows_;
+	std::size_t row_capacity_;  ///< rows allocated for every column
 
 	std::vector<std::string> col_names_;
-	std::vector<std::vector<double>> values_;
+	std::vector<double> values_;  ///< column j starts at j * row_capacity_
 };
 
 MEL_API std::ostream& operator<<(std::ostream& os, const Table& table);
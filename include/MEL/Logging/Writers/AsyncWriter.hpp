@@ -0,0 +1,114 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#ifndef MEL_ASYNCWRITER_HPP
+#define MEL_ASYNCWRITER_HPP
+
+#include <MEL/Config.hpp>
+#include <MEL/Core/NonCopyable.hpp>
+#include <MEL/Core/Types.hpp>
+#include <MEL/Logging/Writers/Writer.hpp>
+#include <MEL/Utility/MpscRing.hpp>
+#include <atomic>
+#include <thread>
+
+namespace mel {
+
+//==============================================================================
+// CLASS DECLARATION
+//==============================================================================
+
+/// Writer that queues Records in a preallocated lock-free ring and passes
+/// them to another Writer on a background thread
+class MEL_API AsyncWriter : public Writer, NonCopyable {
+public:
+    /// Longest message kept per Record, including the terminating null.
+    /// Longer messages are truncated.
+    static const std::size_t MESSAGE_BYTES = 256;
+
+    /// Constructs an AsyncWriter that formats and writes with #writer, which
+    /// must outlive it. #capacity is rounded up to a power of two.
+    AsyncWriter(Writer* writer,
+                std::size_t capacity  = 1024,
+                Severity max_severity = Debug);
+
+    /// Writes everything still queued, then stops the background thread
+    ~AsyncWriter();
+
+    /// Copies #record into the ring. Never locks, allocates or blocks; if the
+    /// ring is full the Record is dropped and counted.
+    virtual void write(const Record& record) override;
+
+    /// Sets the max severity of this and the wrapped Writer
+    virtual void set_max_severity(Severity severity) override;
+
+    /// Blocks until every Record queued before the call has been written
+    void flush();
+
+    /// Returns the number of Records dropped because the ring was full
+    uint64 get_dropped_count() const;
+
+private:
+    struct Slot;
+
+    /// Background thread function
+    void thread_func();
+
+    /// Writes queued Records and returns how many there were
+    std::size_t drain();
+
+private:
+    Writer* writer_;                  ///< Writer that does the formatting and I/O
+    MpscRing<Slot> ring_;             ///< ring of preallocated Records
+    std::atomic<bool> running_;       ///< false to stop the thread
+    std::thread thread_;              ///< background writing thread
+};
+
+}  // namespace mel
+
+#endif  // MEL_ASYNCWRITER_HPP
+
+//==============================================================================
+// CLASS DOCUMENTATION
+//==============================================================================
+
+/// \class mel::AsyncWriter
+/// \ingroup Logging
+///
+/// Logging from a real-time thread with a RollingFileWriter still formats
+/// each Record and may allocate on the caller's thread. An AsyncWriter
+/// instead copies the Record (timestamp, severity, thread id,
+/// source location and up to MESSAGE_BYTES of message) into a slot of a
+/// fixed size ring that any number of threads may fill at once. A
+/// background thread rebuilds each Record and hands it to the wrapped
+/// Writer, so formatting and I/O happen off the caller's thread.
+///
+/// Memory is bounded by the capacity given at construction. When the ring
+/// is full, Records are dropped rather than blocking the caller; check
+/// get_dropped_count() and increase the capacity if it grows.
+///
+/// The default MEL logger writes MEL.log through an AsyncWriter when MEL is
+/// built with the ASYNC_LOG option.
+///
+/// Usage example:
+/// \code
+/// static RollingFileWriter<CsvFormatter> file_writer("my_log.csv");
+/// static AsyncWriter async_writer(&file_writer, 4096);
+/// init_logger<1>(Verbose, &async_writer);
+/// ...
+/// LOG_(1, Info) << "written in the background";
+/// \endcode
@@ -18,10 +18,19 @@
 #ifndef MEL_ROLLINGFILEWRITER_HPP
 #define MEL_ROLLINGFILEWRITER_HPP
 
+#include <MEL/Config.hpp>
+#include <MEL/Core/NonCopyable.hpp>
+#include <MEL/Core/Types.hpp>
 #include <MEL/Logging/File.hpp>
 #include <MEL/Logging/Writers/Writer.hpp>
 #include <MEL/Utility/Mutex.hpp>
-#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace mel {
 
@@ -29,94 +38,76 @@ namespace mel {
 // CLASS DECLARATION
 //==============================================================================
 
-template <class Formatter>
-class RollingFileWriter : public Writer {
+/// Formatter independent part of RollingFileWriter. Stages formatted text in
+/// per-thread buffers and writes and rolls the files on a background thread.
+class MEL_API RollingFileWriterBase : public Writer, NonCopyable {
 public:
-    RollingFileWriter(const char* filename,
-                      size_t max_file_size = 0,
-                      int max_files       = 0,
-                      Severity max_severity = Debug)
-        : Writer(max_severity),
-          file_size_(),
-          max_file_size_(
-              (std::max)(static_cast<off_t>(max_file_size),
-                         static_cast<off_t>(
-                             1000)))  // set a lower limit for the maxFileSize
-          ,
-          last_file_number_((std::max)(max_files - 1, 0)),
-          first_write_(true) {
-        split_file_name(filename, filename_no_ext_, file_ext_);
-    }
-
-    virtual void write(const Record& record) {
-        Lock lock(mutex_);
-
-        if (first_write_) {
-            open_log_file();
-            first_write_ = false;
-        } else if (last_file_number_ > 0 && file_size_ > max_file_size_ &&
-                   -1 != file_size_) {
-            roll_log_files();
-        }
+    /// A thread's staged text is handed to the background thread once it
+    /// reaches this many bytes, rather than at the next periodic flush
+    static const std::size_t STAGE_BYTES = 64 * 1024;
 
-        int bytes_written =
-            file_.write(Formatter::format(record));
+    /// Most text a thread may have staged; Records beyond it are dropped
+    static const std::size_t MAX_STAGE_BYTES = 4 * 1024 * 1024;
 
+    /// Stops the background thread. Derived classes call stop() first.
+    virtual ~RollingFileWriterBase();
 
-        if (bytes_written > 0) {
-            file_size_ += bytes_written;
-        }
-    }
+    /// Blocks until all text staged before the call is written to the file
+    void flush();
 
-private:
-    void roll_log_files() {
-        file_.close();
+    /// Returns the number of Records dropped because a thread's stage was full
+    uint64 get_dropped_count() const;
 
-        std::string lastFileName = build_file_name(last_file_number_);
-        mel::File::unlink(lastFileName.c_str());
+    /// Text staged by one thread
+    struct Stage;
 
-        for (int fileNumber = last_file_number_ - 1; fileNumber >= 0;
-             --fileNumber) {
-            std::string currentFileName = build_file_name(fileNumber);
-            std::string nextFileName    = build_file_name(fileNumber + 1);
+protected:
+    /// Constructor, see RollingFileWriter
+    RollingFileWriterBase(const char* filename,
+                          size_t max_file_size,
+                          int max_files,
+                          Severity max_severity);
 
-            File::rename(currentFileName.c_str(), nextFileName.c_str());
-        }
+    /// Appends #text to the calling thread's stage
+    void stage(const std::string& text);
 
-        open_log_file();
-    }
+    /// Writes everything staged and stops the background thread. Must be
+    /// called by the derived destructor, while header() can still be called.
+    void stop();
 
-    void open_log_file() {
-        std::string fileName = build_file_name();
-        file_size_           = file_.open(fileName.c_str());
+    /// Returns the text written at the start of each new file
+    virtual std::string header() const = 0;
 
-        if (0 == file_size_) {
-            int bytesWritten =
-                file_.write(Formatter::header());
+private:
+    /// Creates and registers a stage for the calling thread
+    std::shared_ptr<Stage> make_stage();
 
-            if (bytesWritten > 0) {
-                file_size_ += bytesWritten;
-            }
-        }
-    }
+    /// Background thread function
+    void thread_func();
 
-    std::string build_file_name(int fileNumber = 0) {
-        std::ostringstream ss;
-        ss << filename_no_ext_;
+    /// Collects every stage into one batch and writes it, rolling the files
+    /// first if needed. Removes the stages of threads that have exited.
+    void write_batch();
 
-        if (fileNumber > 0) {
-            ss << '.' << fileNumber;
-        }
+    void roll_log_files();
 
-        if (!file_ext_.empty()) {
-            ss << '.' << file_ext_;
-        }
+    void open_log_file();
 
-        return ss.str();
-    }
+    std::string build_file_name(int file_number = 0);
 
 private:
-    Mutex mutex_;
+    const uint64 id_;                             ///< unique ID of this writer
+    Mutex stages_mutex_;                          ///< guards stages_
+    std::vector<std::shared_ptr<Stage>> stages_;  ///< one stage per thread
+    std::string batch_;                           ///< text of one batched write
+    std::mutex wake_mutex_;                       ///< guards the fields below
+    std::condition_variable wake_;                ///< wakes the thread early
+    bool wake_requested_;                         ///< a stage is full or flush() waits
+    uint64 batches_;                              ///< batches completed
+    bool running_;                                ///< false to stop the thread
+    std::thread thread_;                          ///< background writing thread
+    std::atomic<uint64> dropped_;                 ///< Records dropped on a full stage
+
     File file_;
     off_t file_size_;
     const off_t max_file_size_;
@@ -125,6 +116,39 @@ private:
     std::string filename_no_ext_;
     bool first_write_;
 };
+
+/// Writer that formats Records with a Formatter into a set of rolling files
+template <class Formatter>
+class RollingFileWriter : public RollingFileWriterBase {
+public:
+    /// Constructs a RollingFileWriter to #filename. When #max_files > 1, the
+    /// file is renamed to filename.1 (and so on) once it exceeds
+    /// #max_file_size bytes, keeping #max_files files.
+    RollingFileWriter(const char* filename,
+                      size_t max_file_size = 0,
+                      int max_files       = 0,
+                      Severity max_severity = Debug)
+        : RollingFileWriterBase(filename, max_file_size, max_files, max_severity) {}
+
+    /// Writes everything staged and closes the file
+    ~RollingFileWriter() {
+        stop();
+    }
+
+    /// Formats #record and stages it for the background thread. Fatal
+    /// Records are written before returning.
+    virtual void write(const Record& record) override {
+        stage(Formatter::format(record));
+        if (record.get_severity() == Fatal)
+            flush();
+    }
+
+protected:
+    virtual std::string header() const override {
+        return Formatter::header();
+    }
+};
+
 }  // namespace mel
 
 #endif // MEL_ROLLINGFILEWRITER_HPP
@@ -132,3 +156,20 @@ private:
 //==============================================================================
 // CLASS DOCUMENTATION
 //==============================================================================
+
+/// \class mel::RollingFileWriter
+/// \ingroup Logging
+///
+/// Records are formatted on the calling thread and appended to a staging
+/// buffer owned by that thread, so concurrent loggers never wait on each
+/// other; the only lock taken is the thread's own, which the background
+/// thread holds just long enough to swap the buffer out. Every few
+/// milliseconds, or as soon as a stage passes STAGE_BYTES, the background
+/// thread gathers all stages into one batch and writes it with a single
+/// system call. Rolling the files also happens on that thread.
+///
+/// Records from one thread are written in order, but Records from different
+/// threads staged within the same batch are grouped by thread rather than
+/// interleaved by time. A stage that reaches MAX_STAGE_BYTES because the
+/// disk can't keep up drops further Records; see get_dropped_count().
+/// Call flush() when the file must be up to date, e.g. before reading it.
@@ -0,0 +1,163 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+
+#ifndef MEL_MPSCRING_HPP
+#define MEL_MPSCRING_HPP
+
+#include <MEL/Core/NonCopyable.hpp>
+#include <MEL/Core/Types.hpp>
+#include <MEL/Utility/System.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace mel {
+
+//==============================================================================
+// CLASS DECLARATION
+//==============================================================================
+
+/// Bounded lock-free queue of preallocated Ts, filled by any number of
+/// threads and emptied by one
+template <typename T>
+class MpscRing : NonCopyable {
+public:
+    /// Constructor. #capacity is rounded up to a power of two.
+    MpscRing(std::size_t capacity)
+        : capacity_(round_capacity(capacity)),
+          cells_(new Cell[capacity_]),
+          head_(0),
+          tail_(0),
+          dropped_(0)
+    {
+        for (std::size_t i = 0; i < capacity_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /// Claims the next free element for the caller to fill, storing its
+    /// position in #pos for publish(). Never locks or blocks; returns NULL
+    /// and counts a drop if the ring is full.
+    T* claim(std::size_t& pos) {
+        pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & (capacity_ - 1)];
+            std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    return &cell.value;
+            }
+            else if (diff < 0) {
+                // the consumer has not freed this element yet
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return NULL;
+            }
+            else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Hands the element claimed at #pos to the consumer
+    void publish(std::size_t pos) {
+        cells_[pos & (capacity_ - 1)].sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    /// Calls #consume on each published element in order, then frees it.
+    /// Returns the number consumed. Call from one thread only.
+    template <typename Consumer>
+    std::size_t drain(Consumer consume) {
+        std::size_t count = 0;
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        for (;; ++tail, ++count) {
+            Cell& cell = cells_[tail & (capacity_ - 1)];
+            if (cell.sequence.load(std::memory_order_acquire) != tail + 1)
+                break;
+            consume(cell.value);
+            cell.sequence.store(tail + capacity_, std::memory_order_release);
+            tail_.store(tail + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /// Blocks until every element claimed before the call has been drained
+    void wait_drained() const {
+        std::size_t head = head_.load(std::memory_order_acquire);
+        while (static_cast<std::ptrdiff_t>(tail_.load(std::memory_order_acquire) - head) < 0)
+            sleep(milliseconds(1));
+    }
+
+    /// Returns the number of elements
+    std::size_t get_capacity() const {
+        return capacity_;
+    }
+
+    /// Returns the number of claims that failed because the ring was full
+    uint64 get_dropped_count() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// An element and the sequence number saying whose turn it is
+    /// (Vyukov's bounded queue): it equals the position when the element is
+    /// free, and the position + 1 once it is published.
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    /// Rounds #n up to a power of two of at least 2, so an element is
+    /// found with a mask
+    static std::size_t round_capacity(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+private:
+    const std::size_t capacity_;      ///< number of elements, a power of two
+    std::unique_ptr<Cell[]> cells_;   ///< preallocated elements
+    char pad0_[64];
+    std::atomic<std::size_t> head_;   ///< next position claimed by producers
+    char pad1_[64];
+    std::atomic<std::size_t> tail_;   ///< next position read by the consumer
+    std::atomic<uint64> dropped_;     ///< claims that found the ring full
+};
+
+}  // namespace mel
+
+#endif  // MEL_MPSCRING_HPP
+
+//==============================================================================
+// CLASS DOCUMENTATION
+//==============================================================================
+
+/// \class mel::MpscRing
+/// \ingroup Utility
+///
+/// The queue behind AsyncWriter and DeferredLog. Producers claim() an
+/// element, fill it in place and publish() it; a single consumer thread
+/// drain()s the published elements in claim order. Memory is allocated
+/// once, so producers never lock, allocate or block. When the ring is full,
+/// claim() fails instead of waiting.
+///
+/// A consumer thread that should stop once the producers are done must
+/// read its stop flag before drain(), and stop only if that drain found
+/// nothing. Reading it after an empty drain misses an element published in
+/// between.
@@ -0,0 +1,87 @@
+// MIT License
+//
+// MEL - Mechatronics Engine & Library
+// Copyright (c) 2018 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+
+#ifndef MEL_PAGEFAULTGUARD_HPP
+#define MEL_PAGEFAULTGUARD_HPP
+
+#include <MEL/Config.hpp>
+#include <MEL/Utility/System.hpp>
+#include <string>
+
+namespace mel {
+
+//==============================================================================
+// CLASS DECLARATION
+//==============================================================================
+
+/// Logs page faults taken by a real-time loop
+class MEL_API PageFaultGuard {
+public:
+    /// Starts watching the faults of the calling thread. #name identifies
+    /// the loop in the log.
+    PageFaultGuard(const std::string& name = "real-time loop");
+
+    /// Logs a warning if the calling thread page faulted since the last
+    /// check() and returns the number of new faults. Call once per loop
+    /// iteration, from the thread that constructed the guard.
+    int64 check();
+
+    /// Gets the faults seen by check() since construction or reset()
+    PageFaults get_faults() const;
+
+    /// Forgets the faults seen so far and starts counting from now
+    void reset();
+
+private:
+    std::string name_;    ///< loop name shown in the log
+    PageFaults last_;     ///< thread's counts at the last check()
+    PageFaults faults_;   ///< faults seen since construction or reset()
+    int64 checks_;        ///< calls of check() since construction or reset()
+};
+
+}  // namespace mel
+
+#endif  // MEL_PAGEFAULTGUARD_HPP
+
+//==============================================================================
+// CLASS DOCUMENTATION
+//==============================================================================
+
+/// \class mel::PageFaultGuard
+/// \ingroup Utility
+///
+/// After prepare_realtime() a real-time loop shouldn't page fault at all,
+/// since every fault can stall it for hundreds of microseconds. A
+/// PageFaultGuard checks that it doesn't: each check() reads the thread's
+/// fault counters with getrusage() (about a microsecond) and logs any new
+/// faults with the iteration they happened on, pointing at memory that was
+/// allocated or first touched inside the loop.
+///
+/// Usage example:
+/// \code
+/// prepare_realtime();
+/// enable_realtime();
+/// PageFaultGuard guard("control loop");
+/// Timer timer(milliseconds(1), Timer::Deadline);
+/// while (!stop) {
+///     ...
+///     guard.check();
+///     timer.wait();
+/// }
+/// print(guard.get_faults().minor);
+/// \endcode
@@ -60,13 +60,39 @@ bool MEL_API enable_realtime();
 /// Disables real-time OS priority. The program must be run 'As Administrator'.
 bool MEL_API disable_realtime();
 
+/// Locks all current and future memory of the process in RAM with mlockall()
+/// and faults in #stack_bytes of the calling thread's stack, a #heap_bytes
+/// heap reserve that later allocations reuse, and every SharedMemory and
+/// MelShare, logging the page faults this took. Call once at startup, from
+/// the thread that will run the real-time loop, before enable_realtime().
+/// Returns false if memory couldn't be locked (run as root or raise
+/// RLIMIT_MEMLOCK); the pages are still faulted in.
+bool MEL_API prepare_realtime(std::size_t stack_bytes = 256 * 1024,
+                              std::size_t heap_bytes = 16 * 1024 * 1024);
+
 /// Gets the operating system's ID number of the calling thread
 uint32 MEL_API get_thread_id();
 
+/// Pins the calling thread to CPU core #cpu. Returns false if the core
+/// doesn't exist or pinning isn't supported (e.g. macOS).
+bool MEL_API set_thread_affinity(int cpu);
+
 //==============================================================================
 // PEROFRMANCE MONITORING FUNCTIONS
 //==============================================================================
 
+/// Page fault counts, see get_page_faults()
+struct PageFaults {
+    int64 major;  ///< faults that had to read from disk
+    int64 minor;  ///< faults served from memory, e.g. first touch of a page
+};
+
+/// Gets the page faults of this process since it started, or of the calling
+/// thread if #this_thread is true (Linux only, else the process's). On
+/// Windows all faults are counted as minor.
+PageFaults MEL_API get_page_faults(bool this_thread = false);
+
+
 /// Gets the CPU core usage as a percent used by all processes
 double MEL_API cpu_usage_total();
 
@@ -0,0 +1,581 @@
+#include <MEL/Communications/EventLoop.hpp>
+#include <MEL/Communications/TcpListener.hpp>
+#include <MEL/Core/Clock.hpp>
+#include <MEL/Logging/Log.hpp>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <basetsd.h>
+#ifdef _WIN32_WINDOWS
+#undef _WIN32_WINDOWS
+#endif
+#ifdef _WIN32_WINNT
+#undef _WIN32_WINNT
+#endif
+#define _WIN32_WINDOWS 0x0501
+#define _WIN32_WINNT 0x0501
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <errno.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#endif
+
+namespace mel {
+
+//==============================================================================
+// IMPLEMENTATION
+//==============================================================================
+
+namespace {
+
+/// What an owned socket is used for
+enum Kind {
+    Listener,  ///< TcpListener accepting clients
+    Tcp,       ///< connected or connecting TcpSocket
+    Udp,       ///< bound UdpSocket
+    Wake       ///< internal UdpSocket that stop() writes to
+};
+
+/// Readiness/interest flags
+enum {
+    Read  = 1,
+    Write = 2
+};
+
+} // namespace
+
+struct EventLoop::Impl {
+
+    /// An owned socket and its callbacks
+    struct Entry {
+        std::unique_ptr<Socket> socket;
+        Kind kind;
+        ConnectCallback on_connect;
+        TcpCallback on_tcp_readable;
+        UdpCallback on_udp_readable;
+        TcpCallback on_writable;
+        bool connecting;  ///< waiting for a non-blocking connect to finish
+        int interest;     ///< Read/Write flags registered with the OS
+        uint32 version;   ///< incremented when the readable callback changes
+    };
+
+    /// A pending timer
+    struct Timer {
+        TimerId id;
+        Time period;
+        TimerCallback callback;
+        bool repeat;
+    };
+
+    /// A socket reported ready by wait()
+    struct Ready {
+        SocketHandle handle;
+        int flags;
+    };
+
+    Impl();
+    ~Impl();
+
+    /// Takes ownership of #socket, NULL if its handle is invalid
+    Entry* add(Socket* socket, Kind kind);
+
+    /// Returns the Entry owning #socket, or NULL
+    Entry* find(Socket& socket);
+
+    /// Registers the Read/Write interest implied by the Entry's state
+    void update(Entry& entry);
+
+    /// Moves #entry out of the loop; it is destroyed once dispatch is over
+    void remove(Entry& entry);
+
+    /// Waits at most #timeout and fills #ready
+    void wait(Time timeout);
+
+    /// Dispatches callbacks for one ready socket
+    std::size_t dispatch(const Ready& ready);
+
+    /// Calls and reschedules all expired timers
+    std::size_t run_timers();
+
+    std::map<SocketHandle, std::unique_ptr<Entry>> entries;  ///< owned sockets
+    std::vector<std::unique_ptr<Entry>> closed;  ///< closed while dispatching
+    std::vector<Ready> ready;                    ///< filled by wait()
+    bool dispatching;                            ///< true inside callbacks
+
+    std::multimap<Time, Timer> timers;  ///< pending timers by deadline
+    TimerId next_timer;                 ///< id of the next add_timer()
+    TimerId current_timer;              ///< timer whose callback is running
+    bool current_cancelled;             ///< current timer cancelled itself
+    Clock clock;                        ///< timer time base
+
+    UdpSocket* wake;                ///< written by stop() to interrupt wait()
+    std::atomic<bool> stopping;     ///< set by stop()
+
+#if defined(__linux__)
+    int epoll;                          ///< epoll instance handle
+    std::vector<epoll_event> events;    ///< buffer filled by epoll_wait
+#endif
+};
+
+EventLoop::Impl::Impl() :
+    dispatching(false),
+    next_timer(1),
+    current_timer(0),
+    current_cancelled(false),
+    wake(NULL),
+    stopping(false)
+{
+#if defined(__linux__)
+    epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll < 0) {
+        LOG(Error) << "Failed to create the epoll instance of the EventLoop";
+    }
+#endif
+    UdpSocket* socket = new UdpSocket;
+    socket->set_blocking(false);
+    socket->bind(Socket::AnyPort, IpAddress::LocalHost);
+    Entry* entry = add(socket, Wake);
+    if (entry)
+        wake = socket;
+}
+
+EventLoop::Impl::~Impl() {
+    entries.clear();
+    closed.clear();
+#if defined(__linux__)
+    if (epoll >= 0)
+        ::close(epoll);
+#endif
+}
+
+EventLoop::Impl::Entry* EventLoop::Impl::add(Socket* socket, Kind kind) {
+    std::unique_ptr<Entry> entry(new Entry);
+    entry->socket.reset(socket);
+    entry->kind       = kind;
+    entry->connecting = false;
+    entry->interest   = 0;
+    entry->version    = 0;
+    SocketHandle handle = socket->get_handle();
+    if (handle == Socket::invalid_socket())
+        return NULL;
+    Entry* e = entry.get();
+    entries[handle] = std::move(entry);
+    update(*e);
+    return e;
+}
+
+EventLoop::Impl::Entry* EventLoop::Impl::find(Socket& socket) {
+    std::map<SocketHandle, std::unique_ptr<Entry>>::iterator it =
+        entries.find(socket.get_handle());
+    if (it == entries.end() || it->second->socket.get() != &socket)
+        return NULL;
+    return it->second.get();
+}
+
+void EventLoop::Impl::update(Entry& entry) {
+    int interest = 0;
+    switch (entry.kind) {
+        case Listener:
+        case Wake:
+            interest = Read;
+            break;
+        case Tcp:
+            if (entry.on_tcp_readable)
+                interest |= Read;
+            if (entry.connecting || entry.on_writable)
+                interest |= Write;
+            break;
+        case Udp:
+            if (entry.on_udp_readable)
+                interest |= Read;
+            break;
+    }
+    if (interest == entry.interest)
+        return;
+#if defined(__linux__)
+    SocketHandle handle = entry.socket->get_handle();
+    uint32 events = 0;
+    if (interest & Read)
+        events |= EPOLLIN;
+    if (interest & Write)
+        events |= EPOLLOUT;
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events  = events;
+    event.data.fd = handle;
+    int op = entry.interest == 0 ? EPOLL_CTL_ADD
+           : interest == 0       ? EPOLL_CTL_DEL
+           : EPOLL_CTL_MOD;
+    if (epoll_ctl(epoll, op, handle, &event) != 0) {
+        LOG(Error) << "Failed to watch socket in EventLoop ("
+                   << std::strerror(errno) << ")";
+        return;
+    }
+#endif
+    entry.interest = interest;
+}
+
+void EventLoop::Impl::remove(Entry& entry) {
+    std::map<SocketHandle, std::unique_ptr<Entry>>::iterator it =
+        entries.find(entry.socket->get_handle());
+#if defined(__linux__)
+    if (entry.interest != 0)
+        epoll_ctl(epoll, EPOLL_CTL_DEL, it->first, NULL);
+#endif
+    // the handle stays open until the Entry dies, so it can't be reused by a
+    // socket accepted later in the same dispatch
+    closed.push_back(std::move(it->second));
+    entries.erase(it);
+    if (!dispatching)
+        closed.clear();
+}
+
+void EventLoop::Impl::wait(Time timeout) {
+    ready.clear();
+#if defined(__linux__)
+    int ms = -1;
+    if (timeout != Time::Inf) {
+        // epoll_wait counts in milliseconds, round up so short waits still wait
+        int64 us = timeout.as_microseconds();
+        ms = static_cast<int>(std::min<int64>((us + 999) / 1000, INT_MAX));
+    }
+    events.resize(std::max<std::size_t>(entries.size(), 1));
+    int count = epoll_wait(epoll, &events[0], static_cast<int>(events.size()), ms);
+    for (int i = 0; i < count; ++i) {
+        Ready r;
+        r.handle = events[i].data.fd;
+        r.flags  = 0;
+        // errors and hangups are reported through the read/write callbacks
+        if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+            r.flags |= Read;
+        if (events[i].events & (EPOLLOUT | EPOLLERR | EPOLLHUP))
+            r.flags |= Write;
+        ready.push_back(r);
+    }
+#else
+    fd_set read_set, write_set, except_set;
+    FD_ZERO(&read_set);
+    FD_ZERO(&write_set);
+    FD_ZERO(&except_set);
+    int max_handle = 0;
+    std::map<SocketHandle, std::unique_ptr<Entry>>::iterator it;
+    for (it = entries.begin(); it != entries.end(); ++it) {
+        SocketHandle handle = it->first;
+#if !defined(_WIN32)
+        if (handle >= FD_SETSIZE)
+            continue;
+        max_handle = std::max(max_handle, static_cast<int>(handle));
+#endif
+        if (it->second->interest & Read)
+            FD_SET(handle, &read_set);
+        if (it->second->interest & Write) {
+            FD_SET(handle, &write_set);
+            // Windows reports failed connects as exceptions
+            FD_SET(handle, &except_set);
+        }
+    }
+    timeval time;
+    time.tv_sec  = static_cast<long>(timeout.as_microseconds() / 1000000);
+    time.tv_usec = static_cast<long>(timeout.as_microseconds() % 1000000);
+    int count = select(max_handle + 1, &read_set, &write_set, &except_set,
+                       timeout != Time::Inf ? &time : NULL);
+    if (count <= 0)
+        return;
+    for (it = entries.begin(); it != entries.end(); ++it) {
+        SocketHandle handle = it->first;
+#if !defined(_WIN32)
+        if (handle >= FD_SETSIZE)
+            continue;
+#endif
+        Ready r;
+        r.handle = handle;
+        r.flags  = 0;
+        if (FD_ISSET(handle, &read_set))
+            r.flags |= Read;
+        if (FD_ISSET(handle, &write_set) || FD_ISSET(handle, &except_set))
+            r.flags |= Write;
+        if (r.flags)
+            ready.push_back(r);
+    }
+#endif
+}
+
+std::size_t EventLoop::Impl::dispatch(const Ready& r) {
+    std::map<SocketHandle, std::unique_ptr<Entry>>::iterator it = entries.find(r.handle);
+    if (it == entries.end())
+        return 0;  // closed by an earlier callback
+    Entry* entry = it->second.get();
+    std::size_t count = 0;
+
+    if (entry->kind == Wake) {
+        char buffer[16];
+        std::size_t received;
+        IpAddress address;
+        unsigned short port;
+        while (wake->receive(buffer, sizeof(buffer), received, address, port) == Socket::Done) {}
+        return 0;
+    }
+
+    if (entry->kind == Listener) {
+        TcpListener& listener = static_cast<TcpListener&>(*entry->socket);
+        std::unique_ptr<TcpSocket> client(new TcpSocket);
+        while (listener.accept(*client) == Socket::Done) {
+            client->set_blocking(false);
+            TcpSocket& socket = *client;
+            if (!add(client.release(), Tcp))
+                break;
+            entry->on_connect(socket, Socket::Done);
+            ++count;
+            if (entries.find(r.handle) == entries.end())
+                break;  // listener closed itself
+            client.reset(new TcpSocket);
+        }
+        return count;
+    }
+
+    if (entry->kind == Udp) {
+        if ((r.flags & Read) && entry->on_udp_readable) {
+            // moved out so the callback may safely replace itself
+            UdpCallback callback(std::move(entry->on_udp_readable));
+            uint32 version = entry->version;
+            callback(static_cast<UdpSocket&>(*entry->socket));
+            if (entry->version == version)
+                entry->on_udp_readable = std::move(callback);
+            ++count;
+        }
+        return count;
+    }
+
+    TcpSocket& socket = static_cast<TcpSocket&>(*entry->socket);
+    if (entry->connecting) {
+        if (r.flags == 0)
+            return 0;
+        entry->connecting = false;
+        update(*entry);
+        Socket::Status status = socket.get_remote_address() != IpAddress::None
+                              ? Socket::Done : Socket::Error;
+        entry->on_connect(socket, status);
+        if (status != Socket::Done && entries.find(r.handle) != entries.end())
+            remove(*entry);
+        return 1;
+    }
+    if ((r.flags & Write) && entry->on_writable) {
+        TcpCallback callback(std::move(entry->on_writable));
+        entry->on_writable = nullptr;
+        update(*entry);
+        callback(socket);
+        ++count;
+        if (entries.find(r.handle) == entries.end())
+            return count;
+    }
+    if ((r.flags & Read) && entry->on_tcp_readable) {
+        TcpCallback callback(std::move(entry->on_tcp_readable));
+        uint32 version = entry->version;
+        callback(socket);
+        if (entry->version == version)
+            entry->on_tcp_readable = std::move(callback);
+        ++count;
+    }
+    return count;
+}
+
+std::size_t EventLoop::Impl::run_timers() {
+    std::size_t count = 0;
+    Time now = clock.get_elapsed_time();
+    while (!timers.empty() && timers.begin()->first <= now) {
+        Time deadline = timers.begin()->first;
+        Timer timer   = std::move(timers.begin()->second);
+        timers.erase(timers.begin());
+        current_timer     = timer.id;
+        current_cancelled = false;
+        timer.callback();
+        ++count;
+        if (timer.repeat && !current_cancelled) {
+            deadline += timer.period;
+            if (deadline <= now)
+                deadline = now + timer.period;
+            timers.insert(std::make_pair(deadline, std::move(timer)));
+        }
+    }
+    current_timer = 0;
+    return count;
+}
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
+EventLoop::EventLoop() :
+    impl_(new Impl)
+{
+}
+
+EventLoop::~EventLoop() {
+}
+
+Socket::Status EventLoop::listen(unsigned short port, ConnectCallback on_connect,
+                                 const IpAddress& address)
+{
+    std::unique_ptr<TcpListener> listener(new TcpListener);
+    listener->set_blocking(false);
+    Socket::Status status = listener->listen(port, address);
+    if (status != Socket::Done)
+        return status;
+    Impl::Entry* entry = impl_->add(listener.release(), Listener);
+    if (!entry)
+        return Socket::Error;
+    entry->on_connect = on_connect;
+    return Socket::Done;
+}
+
+TcpSocket* EventLoop::connect(const IpAddress& address, unsigned short port,
+                              ConnectCallback on_connect)
+{
+    std::unique_ptr<TcpSocket> socket(new TcpSocket);
+    socket->set_blocking(false);
+    Socket::Status status = socket->connect(address, port);
+    if (status != Socket::Done && status != Socket::NotReady)
+        return NULL;
+    TcpSocket* result = socket.get();
+    Impl::Entry* entry = impl_->add(socket.release(), Tcp);
+    if (!entry)
+        return NULL;
+    // even an immediate connection is reported from poll() so that callers
+    // can always finish setting up before on_connect runs
+    entry->on_connect = on_connect;
+    entry->connecting = true;
+    impl_->update(*entry);
+    return result;
+}
+
+UdpSocket* EventLoop::bind(unsigned short port, const IpAddress& address) {
+    std::unique_ptr<UdpSocket> socket(new UdpSocket);
+    socket->set_blocking(false);
+    if (socket->bind(port, address) != Socket::Done)
+        return NULL;
+    UdpSocket* result = socket.get();
+    if (!impl_->add(socket.release(), Udp))
+        return NULL;
+    return result;
+}
+
+void EventLoop::on_readable(TcpSocket& socket, TcpCallback callback) {
+    Impl::Entry* entry = impl_->find(socket);
+    if (!entry) {
+        LOG(Error) << "TcpSocket is not owned by this EventLoop";
+        return;
+    }
+    entry->on_tcp_readable = callback;
+    ++entry->version;
+    impl_->update(*entry);
+}
+
+void EventLoop::on_readable(UdpSocket& socket, UdpCallback callback) {
+    Impl::Entry* entry = impl_->find(socket);
+    if (!entry) {
+        LOG(Error) << "UdpSocket is not owned by this EventLoop";
+        return;
+    }
+    entry->on_udp_readable = callback;
+    ++entry->version;
+    impl_->update(*entry);
+}
+
+void EventLoop::on_writable(TcpSocket& socket, TcpCallback callback) {
+    Impl::Entry* entry = impl_->find(socket);
+    if (!entry) {
+        LOG(Error) << "TcpSocket is not owned by this EventLoop";
+        return;
+    }
+    entry->on_writable = callback;
+    impl_->update(*entry);
+}
+
+void EventLoop::close(Socket& socket) {
+    Impl::Entry* entry = impl_->find(socket);
+    if (entry && entry->kind != Wake)
+        impl_->remove(*entry);
+}
+
+std::size_t EventLoop::get_socket_count() const {
+    return impl_->entries.size() - (impl_->wake ? 1 : 0);
+}
+
+EventLoop::TimerId EventLoop::add_timer(Time period, TimerCallback callback, bool repeat) {
+    if (repeat && period <= Time::Zero) {
+        LOG(Error) << "EventLoop repeating timer period must be greater than zero";
+        return 0;
+    }
+    TimerId id = impl_->next_timer++;
+    Impl::Timer timer;
+    timer.id       = id;
+    timer.period   = period;
+    timer.callback = callback;
+    timer.repeat   = repeat;
+    Time deadline  = impl_->clock.get_elapsed_time() + period;
+    impl_->timers.insert(std::make_pair(deadline, std::move(timer)));
+    return id;
+}
+
+void EventLoop::cancel_timer(TimerId id) {
+    if (id == impl_->current_timer) {
+        impl_->current_cancelled = true;
+        return;
+    }
+    std::multimap<Time, Impl::Timer>::iterator it;
+    for (it = impl_->timers.begin(); it != impl_->timers.end(); ++it) {
+        if (it->second.id == id) {
+            impl_->timers.erase(it);
+            return;
+        }
+    }
+}
+
+std::size_t EventLoop::poll(Time timeout) {
+    if (!impl_->timers.empty()) {
+        Time until = impl_->timers.begin()->first - impl_->clock.get_elapsed_time();
+        if (until < Time::Zero)
+            until = Time::Zero;
+        if (until < timeout)
+            timeout = until;
+    }
+    impl_->wait(timeout);
+    std::size_t count = 0;
+    impl_->dispatching = true;
+    for (std::size_t i = 0; i < impl_->ready.size(); ++i)
+        count += impl_->dispatch(impl_->ready[i]);
+    count += impl_->run_timers();
+    impl_->dispatching = false;
+    impl_->closed.clear();
+    return count;
+}
+
+void EventLoop::run() {
+    while (!impl_->stopping.load())
+        poll();
+    impl_->stopping = false;
+}
+
+void EventLoop::stop() {
+    impl_->stopping = true;
+    if (impl_->wake) {
+        char byte = 0;
+        impl_->wake->send(&byte, 1, IpAddress::LocalHost, impl_->wake->get_local_port());
+    }
+}
+
+} // namespace mel
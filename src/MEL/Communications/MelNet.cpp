@@ -1,5 +1,8 @@
 #include <MEL/Communications/MelNet.hpp>
+#include <MEL/Core/Clock.hpp>
 #include <MEL/Core/Console.hpp>
+#include <MEL/Logging/Log.hpp>
+#include <cstring>
 
 namespace mel {
 
@@ -7,46 +10,126 @@ namespace mel {
 // CLASS DEFINITIONS
 //==============================================================================
 
+static_assert(sizeof(MelNet::Header) == 24, "MelNet::Header must be 24 bytes");
+
 MelNet::MelNet(unsigned short local_port, unsigned short remote_port,
-               IpAddress remote_address, bool blocking) :
+               IpAddress remote_address, bool blocking, Protocol protocol) :
     local_port_(local_port),
     remote_port_(remote_port),
-    remote_address_(remote_address)
+    remote_address_(remote_address),
+    protocol_(protocol),
+    buffer_(UdpSocket::MaxDatagramSize),
+    sequence_(0),
+    received_(false),
+    last_sequence_(0),
+    dropped_(0),
+    reordered_(0),
+    duplicates_(0),
+    history_(0),
+    latency_(Time::Zero)
 {
+    add_peer(remote_address_, remote_port_);
     socket_.bind(local_port_);
     set_blocking(blocking);
 }
 
 void MelNet::send_data(const std::vector<double>& data) {
-    packet_send_.clear();
-    for (std::size_t i = 0; i < data.size(); ++i)
-        packet_send_ << data[i];
-    socket_.send(packet_send_, remote_address_, remote_port_);
+    send_data(data.data(), data.size());
+}
+
+void MelNet::send_data(const double* data, std::size_t size) {
+    if (protocol_ == Framed)
+        send_frame(Data, data, size, size * sizeof(double));
+    else
+        socket_.send(data, size * sizeof(double), remote_address_, remote_port_);
+}
+
+void MelNet::add_peer(IpAddress address, unsigned short port) {
+    UdpSocket::Datagram destination;
+    destination.data     = NULL;
+    destination.size     = 0;
+    destination.received = 0;
+    destination.address  = address;
+    destination.port     = port;
+    destinations_.push_back(destination);
+}
+
+void MelNet::clear_peers() {
+    destinations_.resize(1);
+}
+
+void MelNet::broadcast_data(const std::vector<double>& data) {
+    broadcast_data(data.data(), data.size());
+}
+
+void MelNet::broadcast_data(const double* data, std::size_t size) {
+    void* datagram = const_cast<double*>(data);
+    std::size_t bytes = size * sizeof(double);
+    if (protocol_ == Framed) {
+        bytes = make_frame(Data, data, size, bytes);
+        if (bytes == 0)
+            return;
+        datagram = &buffer_[0];
+    }
+    for (std::size_t i = 0; i < destinations_.size(); ++i) {
+        destinations_[i].data = datagram;
+        destinations_[i].size = bytes;
+    }
+    std::size_t sent;
+    socket_.send_batch(&destinations_[0], destinations_.size(), sent);
 }
 
 std::vector<double> MelNet::receive_data() {
+    std::vector<double> data;
+    receive_data(data);
+    return data;
+}
+
+std::size_t MelNet::receive_data(std::vector<double>& data) {
+    if (protocol_ == Framed) {
+        bool stale;
+        const Header* header = receive_frame(stale);
+        // older than data already returned, so it must not overwrite it
+        if (header && header->type == Data && !stale) {
+            data.resize(header->count);
+            if (!data.empty())
+                std::memcpy(&data[0], header + 1, data.size() * sizeof(double));
+        }
+        else
+            data.clear();
+        return data.size();
+    }
     IpAddress sender;
     unsigned short port;
-    if(socket_.receive(packet_receive_, sender, port) != Socket::NotReady) {
-        std::size_t bytes = packet_receive_.get_data_size();
-        std::size_t size = bytes / 8;
-        std::vector<double> data(size);
-        for (std::size_t i = 0; i < size; ++i)
-            packet_receive_ >> data[i];
-        packet_receive_.clear();
-        return data;
-    } else {
-        return std::vector<double>();
+    std::size_t received = 0;
+    if (socket_.receive(&buffer_[0], buffer_.size(), received, sender, port) == Socket::Done) {
+        data.resize(received / sizeof(double));
+        if (!data.empty())
+            std::memcpy(&data[0], &buffer_[0], data.size() * sizeof(double));
     }
+    else
+        data.clear();
+    return data.size();
 }
 
 void MelNet::send_message(const std::string& message) {
+    if (protocol_ == Framed) {
+        send_frame(Message, message.c_str(), message.size(), message.size());
+        return;
+    }
     packet_send_.clear();
     packet_send_ << message;
     socket_.send(packet_send_, remote_address_, remote_port_);
 }
 
 std::string MelNet::receive_message() {
+    if (protocol_ == Framed) {
+        bool stale;
+        const Header* header = receive_frame(stale);
+        if (header && header->type == Message)
+            return std::string(reinterpret_cast<const char*>(header + 1), header->count);
+        return std::string();
+    }
     IpAddress sender;
     unsigned short port;
     if(socket_.receive(packet_receive_, sender, port) != Socket::NotReady) {
@@ -60,10 +143,18 @@ std::string MelNet::receive_message() {
 }
 
 void MelNet::request() {
-    send_message("request");
+    if (protocol_ == Framed)
+        send_frame(Request, NULL, 0, 0);
+    else
+        send_message("request");
 }
 
 bool MelNet::check_request() {
+    if (protocol_ == Framed) {
+        bool stale;
+        const Header* header = receive_frame(stale);
+        return header && header->type == Request;
+    }
     return receive_message() == "request";
 }
 
@@ -75,4 +166,101 @@ bool MelNet::is_blocking() const {
     return socket_.is_blocking();
 }
 
+MelNet::Protocol MelNet::get_protocol() const {
+    return protocol_;
+}
+
+uint32 MelNet::get_dropped() const {
+    return dropped_;
+}
+
+uint32 MelNet::get_reordered() const {
+    return reordered_;
+}
+
+uint32 MelNet::get_duplicates() const {
+    return duplicates_;
+}
+
+Time MelNet::get_latency() const {
+    return latency_;
+}
+
+std::size_t MelNet::make_frame(Type type, const void* payload, std::size_t count, std::size_t bytes) {
+    if (sizeof(Header) + bytes > buffer_.size() || count > 0xFFFF) {
+        LOG(Error) << "Cannot send MelNet frame of " << count
+                   << " elements (too large for one datagram)";
+        return 0;
+    }
+    Header header;
+    header.magic     = Magic;
+    header.version   = Version;
+    header.type      = static_cast<uint8>(type);
+    header.count     = static_cast<uint16>(count);
+    header.sequence  = sequence_++;
+    header.reserved  = 0;
+    header.timestamp = Clock::get_current_time().as_microseconds();
+    std::memcpy(&buffer_[0], &header, sizeof(Header));
+    if (bytes > 0)
+        std::memcpy(&buffer_[sizeof(Header)], payload, bytes);
+    return sizeof(Header) + bytes;
+}
+
+void MelNet::send_frame(Type type, const void* payload, std::size_t count, std::size_t bytes) {
+    std::size_t size = make_frame(type, payload, count, bytes);
+    if (size > 0)
+        socket_.send(&buffer_[0], size, remote_address_, remote_port_);
+}
+
+const MelNet::Header* MelNet::receive_frame(bool& stale) {
+    stale = false;
+    IpAddress sender;
+    unsigned short port;
+    std::size_t received = 0;
+    if (socket_.receive(&buffer_[0], buffer_.size(), received, sender, port) != Socket::Done)
+        return NULL;
+    Time now = Clock::get_current_time();
+    const Header* header = reinterpret_cast<const Header*>(&buffer_[0]);
+    if (received < sizeof(Header) || header->magic != Magic || header->version != Version) {
+        LOG(Warning) << "MelNet ignored a datagram that is not a version "
+                     << Version << " MelNet frame";
+        return NULL;
+    }
+    std::size_t element = header->type == Data ? sizeof(double) : sizeof(char);
+    if (sizeof(Header) + header->count * element > received) {
+        LOG(Warning) << "MelNet ignored a truncated frame";
+        return NULL;
+    }
+    // signed distance handles sequence numbers wrapping around
+    int32 gap = static_cast<int32>(header->sequence - last_sequence_);
+    if (!received_) {
+        last_sequence_ = header->sequence;
+        history_ = 0;
+    }
+    else if (gap > 0) {
+        dropped_ += static_cast<uint32>(gap - 1);
+        last_sequence_ = header->sequence;
+        // bit i of history_ is set if last_sequence_ - 1 - i was received
+        history_ = gap > 32 ? 0 : ((gap == 32 ? 0 : history_ << gap) | (uint32(1) << (gap - 1)));
+    }
+    else {
+        uint32 age = static_cast<uint32>(-(gap + 1));
+        if (gap == 0 || (age < 32 && (history_ & (uint32(1) << age)))) {
+            // the network delivered a datagram again
+            ++duplicates_;
+            return NULL;
+        }
+        if (age < 32)
+            history_ |= uint32(1) << age;
+        // a late datagram was already counted as dropped when the gap opened
+        ++reordered_;
+        if (dropped_ > 0)
+            --dropped_;
+        stale = true;
+    }
+    received_ = true;
+    latency_ = now - microseconds(header->timestamp);
+    return header;
+}
+
 } // namespace mel
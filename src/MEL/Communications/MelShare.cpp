@@ -1,82 +1,353 @@
 #include <MEL/Communications/MelShare.hpp>
 #include <MEL/Core/Types.hpp>
 #include <MEL/Communications/Packet.hpp>
+#include <MEL/Core/Clock.hpp>
+#include <MEL/Utility/System.hpp>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
 
 namespace mel {
 
+//==============================================================================
+// HELPER FUNCTIONS
+//==============================================================================
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32),
+              "std::atomic<uint32> must be layout compatible with uint32");
+
+/// Returns the seqlock sequence counter at the start of a LockFree MelShare
+inline std::atomic<uint32>* sequence(SharedMemory& shm) {
+    return static_cast<std::atomic<uint32>*>(shm.get_address());
+}
+
+/// Layout of the notify memory map
+struct Notify {
+    std::atomic<uint32> generation;  ///< number of writes, also the futex word
+    std::atomic<uint32> waiters;     ///< number of readers blocked on generation
+};
+
+inline Notify* get_notify(const std::unique_ptr<SharedMemory>& shm) {
+    return static_cast<Notify*>(shm->get_address());
+}
+
+#ifdef __linux__
+
+/// Sleeps while *addr == expected, at most #timeout. The futex is not
+/// FUTEX_PRIVATE since the word is shared between processes.
+inline void futex_wait(std::atomic<uint32>* addr, uint32 expected, Time timeout) {
+    if (timeout == Time::Inf) {
+        syscall(SYS_futex, addr, FUTEX_WAIT, expected, NULL, NULL, 0);
+    }
+    else {
+        int64 us = timeout.as_microseconds();
+        struct timespec ts;
+        ts.tv_sec  = static_cast<time_t>(us / 1000000);
+        ts.tv_nsec = static_cast<long>((us % 1000000) * 1000);
+        syscall(SYS_futex, addr, FUTEX_WAIT, expected, &ts, NULL, 0);
+    }
+}
+
+/// Wakes all threads sleeping on addr
+inline void futex_wake(std::atomic<uint32>* addr) {
+    syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+#endif
+
+} // namespace
+
 //==============================================================================
 // CLASS DEFINITIONS
 //==============================================================================
 
-MelShare::MelShare(const std::string& name, std::size_t max_bytes) :
+MelShare::View::View(MelShare* ms) :
+    ms_(ms),
+    seq_(0)
+{
+    if (ms_->mode_ == LockFree) {
+        // the payload follows two uint32s, so it is 8 byte aligned
+        size_ = ms_->begin_read(seq_) / sizeof(double);
+        data_ = reinterpret_cast<const double*>(ms_->payload());
+    }
+    else {
+        ReadScope read(*ms_);
+        ms_->view_.resize(read.size() / sizeof(double));
+        if (!ms_->view_.empty())
+            std::memcpy(&ms_->view_[0], ms_->payload(), ms_->view_.size() * sizeof(double));
+        size_ = ms_->view_.size();
+        data_ = ms_->view_.data();
+    }
+}
+
+MelShare::View::View(View&& other) :
+    ms_(other.ms_),
+    seq_(other.seq_),
+    data_(other.data_),
+    size_(other.size_)
+{
+    other.ms_ = nullptr;
+}
+
+MelShare::View::~View() { }
+
+const double* MelShare::View::data() const {
+    return data_;
+}
+
+std::size_t MelShare::View::size() const {
+    return size_;
+}
+
+const double& MelShare::View::operator[](std::size_t index) const {
+    return data_[index];
+}
+
+const double* MelShare::View::begin() const {
+    return data_;
+}
+
+const double* MelShare::View::end() const {
+    return data_ + size_;
+}
+
+bool MelShare::View::is_valid() const {
+    if (ms_ && ms_->mode_ == LockFree)
+        return ms_->end_read(seq_);
+    return true;
+}
+
+MelShare::ReadScope::ReadScope(MelShare& ms) :
+    ms_(ms),
+    seq_(0),
+    ended_(false)
+{
+    size_ = ms_.begin_read(seq_);
+}
+
+MelShare::ReadScope::~ReadScope() {
+    if (!ended_)
+        ms_.end_read(seq_);
+}
+
+uint32 MelShare::ReadScope::size() const {
+    return size_;
+}
+
+bool MelShare::ReadScope::end() {
+    ended_ = true;
+    return ms_.end_read(seq_);
+}
+
+MelShare::MelShare(const std::string& name,
+                   std::size_t max_bytes,
+                   Mode mode,
+                   bool notify) :
     shm_(name, max_bytes),
-    mutex_(name + "_mutex")
+    mutex_(name + "_mutex"),
+    mode_(mode),
+    offset_(mode == LockFree ? sizeof(uint32) : 0),
+    scratch_(mode == LockFree ? max_bytes : 0),
+    notify_(notify ? new SharedMemory(name + "_notify", sizeof(Notify)) : nullptr),
+    generation_(notify ? get_notify(notify_)->generation.load() : 0)
 {
 }
 
 void MelShare::write(Packet& packet) {
-    Lock lock(mutex_);
     std::size_t size = 0;
     const void* data = packet.on_send(size);
-    uint32 size32 = static_cast<uint32>(size);
-    shm_.write(&size32, sizeof(uint32));
-    shm_.write(data, size, sizeof(uint32));
+    write_frame(data, static_cast<uint32>(size));
 }
 
 void MelShare::read(Packet& packet) {
-    Lock lock(mutex_);
-    uint32 size32 = get_size();
-    std::size_t size = static_cast<std::size_t>(size32);
-    if (size > 0) {
-        std::vector<char> data(size);
-        shm_.read(&data[0], size, sizeof(uint32));
-        packet.on_receive(&data[0], size);
+    if (mode_ == LockFree) {
+        // Packets can't be rolled back, so copy out until a frame is whole
+        uint32 size;
+        for (;;) {
+            ReadScope read(*this);
+            size = read.size();
+            std::memcpy(&scratch_[0], payload(), size);
+            if (read.end())
+                break;
+        }
+        if (size > 0)
+            packet.on_receive(&scratch_[0], static_cast<std::size_t>(size));
+    }
+    else {
+        ReadScope read(*this);
+        if (read.size() > 0)
+            packet.on_receive(payload(), static_cast<std::size_t>(read.size()));
     }
 }
 
 void MelShare::write_data(const std::vector<double>& data) {
-    Lock lock(mutex_);
-    uint32 size = static_cast<uint32>(data.size() * sizeof(double));
-    shm_.write(&size, sizeof(uint32));
-    shm_.write(&data[0], size, sizeof(uint32));
+    write_data(data.data(), data.size());
+}
+
+void MelShare::write_data(const double* data, std::size_t size) {
+    write_frame(data, static_cast<uint32>(size * sizeof(double)));
 }
 
 std::vector<double> MelShare::read_data() {
-    Lock lock(mutex_);
-    uint32 size = get_size();
-    if (size > 0) {
-        std::vector<double> data(size / sizeof(double));
-        shm_.read(&data[0], size, sizeof(uint32));
-        return data;
+    std::vector<double> data;
+    read_data(data);
+    return data;
+}
+
+std::size_t MelShare::read_data(std::vector<double>& data) {
+    for (;;) {
+        ReadScope read(*this);
+        data.resize(read.size() / sizeof(double));
+        if (!data.empty())
+            std::memcpy(&data[0], payload(), data.size() * sizeof(double));
+        if (read.end())
+            return data.size();
     }
-    else
-        return std::vector<double>();
+}
+
+MelShare::View MelShare::view_data() {
+    return View(this);
 }
 
 void MelShare::write_message(const std::string &message) {
-    Lock lock(mutex_);
-    uint32 size = static_cast<uint32>(message.length() + 1);
-    shm_.write(&size, sizeof(uint32));
-    shm_.write(message.c_str(), size, sizeof(uint32));
+    write_frame(message.c_str(), static_cast<uint32>(message.length() + 1));
 }
 
 std::string MelShare::read_message() {
-    Lock lock(mutex_);
-    uint32 size = get_size();
-    if (size > 0) {
-        std::vector<char> message(size);
-        shm_.read(&message[0], size, sizeof(uint32));
-        return std::string(&message[0]);
+    std::string message;
+    read_message(message);
+    return message;
+}
+
+void MelShare::read_message(std::string& message) {
+    for (;;) {
+        ReadScope read(*this);
+        message.assign(payload(), strnlen(payload(), read.size()));
+        if (read.end())
+            return;
     }
-    else
-        return std::string();
+}
+
+bool MelShare::wait_for_write(Time timeout) {
+    if (!notify_)
+        return false;
+    Notify* n = get_notify(notify_);
+    Clock clock;
+    for (;;) {
+        uint32 generation = n->generation.load();
+        if (generation != generation_) {
+            generation_ = generation;
+            return true;
+        }
+        Time remaining = timeout == Time::Inf ? Time::Inf : timeout - clock.get_elapsed_time();
+        if (remaining <= Time::Zero)
+            return false;
+#ifdef __linux__
+        // announce ourselves before sleeping so the writer knows to wake us
+        n->waiters.fetch_add(1);
+        futex_wait(&n->generation, generation, remaining);
+        n->waiters.fetch_sub(1);
+#else
+        sleep(remaining < milliseconds(1) ? remaining : milliseconds(1));
+#endif
+    }
+}
+
+MelShare::Mode MelShare::get_mode() const {
+    return mode_;
 }
 
 uint32 MelShare::get_size() {
     uint32 size;
-    shm_.read(&size, sizeof(uint32));
+    shm_.read(&size, sizeof(uint32), offset_);
+    return size;
+}
+
+void MelShare::write_frame(const void* data, uint32 size) {
+    if (offset_ + sizeof(uint32) + size > shm_.get_max_bytes())
+        return;
+    begin_write();
+    shm_.write(&size, sizeof(uint32), offset_);
+    shm_.write(data, size, offset_ + sizeof(uint32));
+    end_write();
+}
+
+void MelShare::begin_write() {
+    if (mode_ == LockFree) {
+        // odd sequence marks the frame as being written
+        std::atomic<uint32>* seq = sequence(shm_);
+        seq->store(seq->load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    else
+        mutex_.lock();
+}
+
+void MelShare::end_write() {
+    if (mode_ == LockFree) {
+        std::atomic<uint32>* seq = sequence(shm_);
+        seq->store(seq->load(std::memory_order_relaxed) + 1,
+                   std::memory_order_release);
+    }
+    else
+        mutex_.unlock();
+    if (notify_)
+        notify();
+}
+
+uint32 MelShare::begin_read(uint32& seq) {
+    if (mode_ == LockFree) {
+        // wait out a writer that is mid-frame
+        while ((seq = sequence(shm_)->load(std::memory_order_acquire)) & 1)
+            std::this_thread::yield();
+    }
+    else
+        mutex_.lock();
+    uint32 size = get_size();
+    // a torn size may be garbage, so never trust it past capacity
+    std::size_t capacity = shm_.get_max_bytes() - offset_ - sizeof(uint32);
+    if (size > capacity)
+        size = static_cast<uint32>(capacity);
     return size;
 }
 
+bool MelShare::end_read(uint32 seq) {
+    if (mode_ == LockFree) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence(shm_)->load(std::memory_order_relaxed) == seq;
+    }
+    mutex_.unlock();
+    return true;
+}
+
+const char* MelShare::payload() const {
+    return static_cast<const char*>(shm_.get_address()) + offset_ + sizeof(uint32);
+}
+
+char* MelShare::payload() {
+    return static_cast<char*>(shm_.get_address()) + offset_ + sizeof(uint32);
+}
+
+void MelShare::notify() {
+    Notify* n = get_notify(notify_);
+    // sequentially consistent so that either a reader sees the new generation
+    // before sleeping, or the writer sees the reader waiting and wakes it
+    n->generation.fetch_add(1);
+#ifdef __linux__
+    if (n->waiters.load() > 0)
+        futex_wake(&n->generation);
+#endif
+}
 
 } // namespace mel
@@ -0,0 +1,187 @@
+#include <MEL/Communications/MelStream.hpp>
+#include <MEL/Logging/Log.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace mel {
+
+//==============================================================================
+// HEADER LAYOUT
+//==============================================================================
+
+namespace {
+
+/// Size of the MelStream header in bytes (three cache lines)
+const std::size_t HEADER_BYTES = 192;
+
+/// Size of the per slot sample count in bytes (padded to keep doubles aligned)
+const std::size_t COUNT_BYTES = sizeof(double);
+
+/// Rounds #n up to the next power of two so free running uint32 counters
+/// map onto the same slot after they wrap around
+std::size_t next_pow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+} // namespace
+
+struct MelStream::Header {
+    std::atomic<uint32> head;      ///< samples written, moved by the producer
+    char pad0[64 - sizeof(uint32)];
+    std::atomic<uint32> tail;      ///< samples read, moved by the consumer
+    char pad1[64 - sizeof(uint32)];
+    std::atomic<uint32> overruns;  ///< samples dropped because of a full stream
+    uint32 slot_count;             ///< number of slots
+    uint32 slot_size;              ///< maximum number of doubles per slot
+};
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
+MelStream::MelStream(const std::string& name,
+                     std::size_t slot_count,
+                     std::size_t slot_size) :
+    shm_(name, HEADER_BYTES + next_pow2(slot_count) * (COUNT_BYTES + slot_size * sizeof(double))),
+    slot_count_(next_pow2(slot_count)),
+    slot_size_(slot_size),
+    slot_bytes_(COUNT_BYTES + slot_size * sizeof(double))
+{
+    static_assert(sizeof(Header) <= HEADER_BYTES, "MelStream::Header too large");
+    Header* h = header();
+    if (h->slot_count == 0) {
+        h->slot_count = static_cast<uint32>(slot_count_);
+        h->slot_size  = static_cast<uint32>(slot_size_);
+    }
+    else if (h->slot_count != slot_count_ || h->slot_size != slot_size_) {
+        // the creator's geometry wins so both sides index the same slots,
+        // as long as its slots fit in what we mapped
+        std::size_t count = h->slot_count;
+        std::size_t size  = h->slot_size;
+        std::size_t bytes = COUNT_BYTES + size * sizeof(double);
+        if (count == next_pow2(count) && HEADER_BYTES + count * bytes <= shm_.get_max_bytes()) {
+            LOG(Warning) << "MelStream " << name << " was opened with "
+                         << slot_count_ << " x " << slot_size_
+                         << " slots but was created with " << count
+                         << " x " << size << " slots. Using " << count
+                         << " x " << size << " slots.";
+            slot_count_ = count;
+            slot_size_  = size;
+            slot_bytes_ = bytes;
+        }
+        else {
+            LOG(Error) << "MelStream " << name << " was opened with "
+                       << slot_count_ << " x " << slot_size_
+                       << " slots but was created with " << count
+                       << " x " << size << " slots, which do not fit. "
+                       << "All reads and writes will fail.";
+            slot_count_ = 0;
+            slot_size_  = 0;
+        }
+    }
+}
+
+bool MelStream::is_valid() const {
+    return slot_count_ != 0;
+}
+
+bool MelStream::write_data(const std::vector<double>& data) {
+    return write_data(data.data(), data.size());
+}
+
+bool MelStream::write_data(const double* data, std::size_t size) {
+    if (!is_valid() || size > slot_size_)
+        return false;
+    Header* h = header();
+    uint32 head = h->head.load(std::memory_order_relaxed);
+    uint32 tail = h->tail.load(std::memory_order_acquire);
+    if (head - tail >= slot_count_) {
+        h->overruns.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    char* s = slot(head);
+    uint32 n = static_cast<uint32>(size);
+    std::memcpy(s, &n, sizeof(uint32));
+    std::memcpy(s + COUNT_BYTES, data, size * sizeof(double));
+    h->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool MelStream::read_data(std::vector<double>& data) {
+    if (!is_valid())
+        return false;
+    Header* h = header();
+    uint32 tail = h->tail.load(std::memory_order_relaxed);
+    uint32 head = h->head.load(std::memory_order_acquire);
+    if (head == tail)
+        return false;
+    const char* s = slot(tail);
+    uint32 n;
+    std::memcpy(&n, s, sizeof(uint32));
+    data.resize(std::min<std::size_t>(n, slot_size_));
+    if (!data.empty())
+        std::memcpy(&data[0], s + COUNT_BYTES, data.size() * sizeof(double));
+    h->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+std::vector<std::vector<double>> MelStream::read_all() {
+    std::vector<std::vector<double>> samples(get_available());
+    for (std::size_t i = 0; i < samples.size(); ++i)
+        read_data(samples[i]);
+    return samples;
+}
+
+std::size_t MelStream::read_all(std::vector<double>& data) {
+    data.clear();
+    if (!is_valid())
+        return 0;
+    Header* h = header();
+    uint32 tail = h->tail.load(std::memory_order_relaxed);
+    uint32 head = h->head.load(std::memory_order_acquire);
+    std::size_t count = head - tail;
+    for (; tail != head; ++tail) {
+        const char* s = slot(tail);
+        uint32 n;
+        std::memcpy(&n, s, sizeof(uint32));
+        const double* values = reinterpret_cast<const double*>(s + COUNT_BYTES);
+        data.insert(data.end(), values, values + std::min<std::size_t>(n, slot_size_));
+    }
+    h->tail.store(tail, std::memory_order_release);
+    return count;
+}
+
+std::size_t MelStream::get_available() const {
+    if (!is_valid())
+        return 0;
+    Header* h = header();
+    return h->head.load(std::memory_order_acquire) -
+           h->tail.load(std::memory_order_acquire);
+}
+
+uint32 MelStream::get_overruns() const {
+    return header()->overruns.load(std::memory_order_relaxed);
+}
+
+std::size_t MelStream::get_slot_count() const {
+    return slot_count_;
+}
+
+std::size_t MelStream::get_slot_size() const {
+    return slot_size_;
+}
+
+MelStream::Header* MelStream::header() const {
+    return static_cast<Header*>(shm_.get_address());
+}
+
+char* MelStream::slot(uint32 index) const {
+    return static_cast<char*>(shm_.get_address()) + HEADER_BYTES +
+           (index & (slot_count_ - 1)) * slot_bytes_;
+}
+
+} // namespace mel
@@ -1,7 +1,9 @@
 #include <MEL/Communications/SharedMemory.hpp>
 #include <MEL/Logging/Log.hpp>
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <mutex>
 
 #ifdef _WIN32
 #include <conio.h>
@@ -19,6 +21,29 @@
 
 namespace mel {
 
+//==============================================================================
+// HELPER FUNCTIONS
+//==============================================================================
+
+namespace {
+
+/// Guards registry()
+std::mutex& registry_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+/// Every SharedMemory in the process, for SharedMemory::prefault_all()
+std::vector<const SharedMemory*>& registry() {
+    static std::vector<const SharedMemory*> maps;
+    return maps;
+}
+
+/// Smallest unit the OS maps memory in
+const std::size_t PAGE_BYTES = 4096;
+
+} // namespace
+
 //==============================================================================
 // COMMON IMPLEMENTATION
 //==============================================================================
@@ -27,9 +52,18 @@ SharedMemory::SharedMemory(const std::string& name, std::size_t max_bytes)
     : name_(name),
       max_bytes_(max_bytes),
       map_(create_or_open(name_, max_bytes_)),
-      buffer_(map_buffer(map_, max_bytes_)) {}
+      buffer_(map_buffer(map_, max_bytes_))
+{
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    registry().push_back(this);
+}
 
 SharedMemory::~SharedMemory() {
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        std::vector<const SharedMemory*>& maps = registry();
+        maps.erase(std::remove(maps.begin(), maps.end(), this), maps.end());
+    }
     unmap_buffer(buffer_, max_bytes_);
     close(name_, map_);
 }
@@ -62,6 +96,33 @@ std::string SharedMemory::get_name() const {
     return name_;
 }
 
+/// Returns the size of the mapped region in bytes
+std::size_t SharedMemory::get_max_bytes() const {
+    return max_bytes_;
+}
+
+std::size_t SharedMemory::prefault() const {
+    if (!buffer_ || max_bytes_ == 0)
+        return 0;
+    // reading is enough: other processes may be writing, so don't store
+    const volatile char* bytes = static_cast<const volatile char*>(buffer_);
+    char sink = 0;
+    for (std::size_t i = 0; i < max_bytes_; i += PAGE_BYTES)
+        sink ^= bytes[i];
+    sink ^= bytes[max_bytes_ - 1];
+    (void)sink;
+    return max_bytes_;
+}
+
+std::size_t SharedMemory::prefault_all() {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    const std::vector<const SharedMemory*>& maps = registry();
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < maps.size(); ++i)
+        bytes += maps[i]->prefault();
+    return bytes;
+}
+
 #ifdef _WIN32
 
 //==============================================================================
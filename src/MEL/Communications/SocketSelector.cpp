@@ -31,12 +31,160 @@
 #include <unistd.h>
 #endif
 
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <vector>
+#endif
+
 #ifdef _MSC_VER
 #pragma warning(disable : 4127)  // "conditional expression is constant"
                                  // generated by the FD_SET macro
 #endif
 
 namespace mel {
+
+#if defined(__linux__)
+
+//==============================================================================
+// EPOLL IMPLEMENTATION
+//==============================================================================
+
+namespace {
+
+/// Per handle state flags
+enum {
+    Registered = 1,  ///< handle was added to the epoll set
+    Ready      = 2   ///< handle was reported by the last wait()
+};
+
+} // namespace
+
+struct SocketSelector::SocketSelectorImpl {
+    int epoll;                         ///< epoll instance handle
+    std::vector<unsigned char> state;  ///< Registered/Ready flags indexed by handle
+    std::vector<int> ready;            ///< Handles flagged Ready by the last wait()
+    std::vector<epoll_event> events;   ///< Buffer filled by epoll_wait
+    int socketCount;                   ///< Number of socket handles
+};
+
+SocketSelector::SocketSelector() : impl_(new SocketSelectorImpl) {
+    impl_->epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (impl_->epoll < 0) {
+        LOG(Error) << "Failed to create the epoll instance of the selector";
+    }
+    impl_->socketCount = 0;
+}
+
+SocketSelector::SocketSelector(const SocketSelector& copy)
+    : impl_(new SocketSelectorImpl) {
+    impl_->epoll = epoll_create1(EPOLL_CLOEXEC);
+    impl_->socketCount = 0;
+    impl_->state.resize(copy.impl_->state.size(), 0);
+    for (std::size_t handle = 0; handle < copy.impl_->state.size(); ++handle) {
+        if (copy.impl_->state[handle] & Registered) {
+            epoll_event event;
+            std::memset(&event, 0, sizeof(event));
+            event.events  = EPOLLIN;
+            event.data.fd = static_cast<int>(handle);
+            if (epoll_ctl(impl_->epoll, EPOLL_CTL_ADD, event.data.fd, &event) == 0) {
+                impl_->state[handle] = Registered;
+                impl_->socketCount++;
+            }
+        }
+    }
+}
+
+SocketSelector::~SocketSelector() {
+    if (impl_->epoll >= 0)
+        close(impl_->epoll);
+    delete impl_;
+}
+
+void SocketSelector::add(Socket& socket) {
+    SocketHandle handle = socket.get_handle();
+    if (handle != Socket::invalid_socket()) {
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events  = EPOLLIN;
+        event.data.fd = handle;
+        // a closed handle leaves epoll on its own, so Registered may be stale
+        // if the number was reused; let the kernel decide with EEXIST
+        if (epoll_ctl(impl_->epoll, EPOLL_CTL_ADD, handle, &event) != 0) {
+            if (errno != EEXIST) {
+                LOG(Error) << "The socket can't be added to the selector ("
+                           << std::strerror(errno) << ")";
+                return;
+            }
+        }
+        if (static_cast<std::size_t>(handle) >= impl_->state.size())
+            impl_->state.resize(handle + 1, 0);
+        if (!(impl_->state[handle] & Registered)) {
+            impl_->state[handle] |= Registered;
+            impl_->socketCount++;
+        }
+    }
+}
+
+void SocketSelector::remove(Socket& socket) {
+    SocketHandle handle = socket.get_handle();
+    if (handle != Socket::invalid_socket()) {
+        if (static_cast<std::size_t>(handle) >= impl_->state.size() ||
+            !(impl_->state[handle] & Registered))
+            return;
+        epoll_ctl(impl_->epoll, EPOLL_CTL_DEL, handle, NULL);
+        impl_->state[handle] = 0;
+        impl_->socketCount--;
+    }
+}
+
+void SocketSelector::clear() {
+    for (std::size_t handle = 0; handle < impl_->state.size(); ++handle) {
+        if (impl_->state[handle] & Registered)
+            epoll_ctl(impl_->epoll, EPOLL_CTL_DEL, static_cast<int>(handle), NULL);
+    }
+    impl_->state.clear();
+    impl_->ready.clear();
+    impl_->socketCount = 0;
+}
+
+bool SocketSelector::wait(Time timeout) {
+    // Forget the sockets reported by the previous wait, O(ready)
+    for (std::size_t i = 0; i < impl_->ready.size(); ++i) {
+        if (static_cast<std::size_t>(impl_->ready[i]) < impl_->state.size())
+            impl_->state[impl_->ready[i]] &= ~Ready;
+    }
+    impl_->ready.clear();
+    impl_->events.resize(std::max(impl_->socketCount, 1));
+    // epoll_wait counts in milliseconds, round up so short timeouts still wait
+    int ms = -1;
+    if (timeout != Time::Zero)
+        ms = static_cast<int>((timeout.as_microseconds() + 999) / 1000);
+    int count = epoll_wait(impl_->epoll, &impl_->events[0],
+                           static_cast<int>(impl_->events.size()), ms);
+    for (int i = 0; i < count; ++i) {
+        int handle = impl_->events[i].data.fd;
+        if (static_cast<std::size_t>(handle) < impl_->state.size()) {
+            impl_->state[handle] |= Ready;
+            impl_->ready.push_back(handle);
+        }
+    }
+    return count > 0;
+}
+
+bool SocketSelector::is_ready(Socket& socket) const {
+    SocketHandle handle = socket.get_handle();
+    if (handle != Socket::invalid_socket() &&
+        static_cast<std::size_t>(handle) < impl_->state.size())
+        return (impl_->state[handle] & Ready) != 0;
+    return false;
+}
+
+#else
+
+//==============================================================================
+// SELECT IMPLEMENTATION
+//==============================================================================
+
 struct SocketSelector::SocketSelectorImpl {
     fd_set allSockets;  ///< Set containing all the sockets handles
     fd_set
@@ -135,6 +283,8 @@ bool SocketSelector::is_ready(Socket& socket) const {
     return false;
 }
 
+#endif
+
 SocketSelector& SocketSelector::operator=(const SocketSelector& right) {
     SocketSelector temp(right);
     std::swap(impl_, temp.impl_);
@@ -108,6 +108,7 @@ Socket::Status TcpListener::accept(TcpSocket& socket)
     // Initialize the new connected socket
     socket.close();
     socket.create(remote);
+    socket.apply_options();
 
     return Done;
 }
@@ -27,6 +27,7 @@
 #include <unistd.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/uio.h>
 #endif
 
 #ifdef _MSC_VER
@@ -41,12 +42,17 @@ namespace
     #else
         const int flags = 0;
     #endif
+
+    // Minimum capacity of the packet receive buffer, allocated on first use
+    const std::size_t PACKET_BUFFER_SIZE = 65536;
 }
 
 namespace mel
 {
 TcpSocket::TcpSocket() :
-Socket(Tcp)
+Socket(Tcp),
+no_delay_(true),
+send_buffer_size_(0)
 {
 
 }
@@ -121,6 +127,8 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
     {
         // ----- We're not using a timeout: just try to connect -----
 
+        apply_options();
+
         // Connect the socket
         if (::connect(get_handle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
             return Socket::get_error_status();
@@ -132,6 +140,8 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
     {
         // ----- We're using a timeout: we'll need a few tricks to make it work -----
 
+        apply_options();
+
         // Save the previous blocking state
         bool blocking = is_blocking();
 
@@ -203,8 +213,65 @@ void TcpSocket::disconnect()
     // Close the socket
     close();
 
-    // Reset the pending packet data
-    pending_packet_ = PendingPacket();
+    // Reset the pending packet data, keeping the buffer
+    pending_packet_.Size         = 0;
+    pending_packet_.SizeReceived = 0;
+    pending_packet_.DataReceived = 0;
+}
+
+
+void TcpSocket::set_no_delay(bool no_delay)
+{
+    no_delay_ = no_delay;
+    apply_options();
+}
+
+
+bool TcpSocket::get_no_delay() const
+{
+    return no_delay_;
+}
+
+
+void TcpSocket::set_send_buffer_size(std::size_t size)
+{
+    send_buffer_size_ = size;
+    apply_options();
+}
+
+
+std::size_t TcpSocket::get_send_buffer_size() const
+{
+    if (get_handle() != Socket::invalid_socket())
+    {
+        int size = 0;
+        Socket::AddrLength length = sizeof(size);
+        if (getsockopt(get_handle(), SOL_SOCKET, SO_SNDBUF, reinterpret_cast<char*>(&size), &length) != -1)
+            return static_cast<std::size_t>(size);
+    }
+    return 0;
+}
+
+
+void TcpSocket::apply_options()
+{
+    if (get_handle() == Socket::invalid_socket())
+        return;
+
+    int noDelay = no_delay_ ? 1 : 0;
+    if (setsockopt(get_handle(), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<char*>(&noDelay), sizeof(noDelay)) == -1)
+    {
+        LOG(mel::Warning) << "Failed to set socket option \"TCP_NODELAY\"";
+    }
+
+    if (send_buffer_size_ > 0)
+    {
+        int size = static_cast<int>(send_buffer_size_);
+        if (setsockopt(get_handle(), SOL_SOCKET, SO_SNDBUF, reinterpret_cast<char*>(&size), sizeof(size)) == -1)
+        {
+            LOG(mel::Warning) << "Failed to set socket option \"SO_SNDBUF\"";
+        }
+    }
 }
 
 
@@ -249,6 +316,62 @@ Socket::Status TcpSocket::send(const void* data, std::size_t size, std::size_t&
 }
 
 
+Socket::Status TcpSocket::send(const void* first, std::size_t first_size,
+                               const void* second, std::size_t second_size,
+                               std::size_t& sent)
+{
+    std::size_t size = first_size + second_size;
+
+    // Loop until every byte has been sent
+    for (sent = 0; sent < size;)
+    {
+        // Point the buffers at whatever remains of each block
+        const char* a = static_cast<const char*>(first) + std::min(sent, first_size);
+        std::size_t aSize = first_size - std::min(sent, first_size);
+        const char* b = static_cast<const char*>(second) + (sent > first_size ? sent - first_size : 0);
+        std::size_t bSize = second_size - (sent > first_size ? sent - first_size : 0);
+
+        // Send a chunk of data
+#ifdef _WIN32
+        WSABUF buffers[2];
+        buffers[0].buf = const_cast<char*>(a);
+        buffers[0].len = static_cast<ULONG>(aSize);
+        buffers[1].buf = const_cast<char*>(b);
+        buffers[1].len = static_cast<ULONG>(bSize);
+        DWORD count = 0;
+        int result = WSASend(get_handle(), aSize > 0 ? buffers : buffers + 1, aSize > 0 ? 2 : 1, &count, 0, NULL, NULL) == 0
+                   ? static_cast<int>(count) : -1;
+#else
+        iovec buffers[2];
+        buffers[0].iov_base = const_cast<char*>(a);
+        buffers[0].iov_len  = aSize;
+        buffers[1].iov_base = const_cast<char*>(b);
+        buffers[1].iov_len  = bSize;
+        msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_iov    = aSize > 0 ? buffers : buffers + 1;
+        message.msg_iovlen = aSize > 0 ? 2 : 1;
+        ssize_t result = sendmsg(get_handle(), &message, flags);
+#endif
+
+        // Check for errors
+        if (result < 0)
+        {
+            Status status = Socket::get_error_status();
+
+            if ((status == NotReady) && sent)
+                return Partial;
+
+            return status;
+        }
+
+        sent += static_cast<std::size_t>(result);
+    }
+
+    return Done;
+}
+
+
 Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& received)
 {
     // First clear the variables to fill
@@ -287,10 +410,9 @@ Socket::Status TcpSocket::send(Packet& packet)
     // This means that we have to send the packet size first, so that the
     // receiver knows the actual end of the packet in the data stream.
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
+    // The size and the data are handed to the OS together in a single
+    // scatter-gather call, which avoids both a copy into a contiguous block
+    // and a partial send between the size and the data.
 
     // Get the data to send from the packet
     std::size_t size = 0;
@@ -299,17 +421,27 @@ Socket::Status TcpSocket::send(Packet& packet)
     // First convert the packet size to network byte order
     uint32 packetSize = htonl(static_cast<uint32>(size));
 
-    // Allocate memory for the data block to send
-    std::vector<char> blockToSend(sizeof(packetSize) + size);
-
-    // Copy the packet size and data into the block to send
-    std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-    if (size > 0)
-        std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
+    // Skip whatever a previous partial send already delivered
+    std::size_t offset = packet.send_pos_;
+    const char* header = reinterpret_cast<const char*>(&packetSize);
+    std::size_t headerSize = sizeof(packetSize);
+    const char* body = static_cast<const char*>(data);
+    std::size_t bodySize = size;
+    if (offset < headerSize)
+    {
+        header += offset;
+        headerSize -= offset;
+    }
+    else
+    {
+        body += offset - headerSize;
+        bodySize -= offset - headerSize;
+        headerSize = 0;
+    }
 
     // Send the data block
     std::size_t sent;
-    Status status = send(&blockToSend[0] + packet.send_pos_, blockToSend.size() - packet.send_pos_, sent);
+    Status status = send(header, headerSize, body, bodySize, sent);
 
     // In the case of a partial send, record the location to resume from
     if (status == Partial)
@@ -356,31 +488,33 @@ Socket::Status TcpSocket::receive(Packet& packet)
         packetSize = ntohl(pending_packet_.Size);
     }
 
-    // Loop until we receive all the packet data
-    char buffer[1024];
-    while (pending_packet_.Data.size() < packetSize)
+    // Loop until we receive all the packet data, straight into the buffer
+    while (pending_packet_.DataReceived < packetSize)
     {
-        // Receive a chunk of data
-        std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - pending_packet_.Data.size()), sizeof(buffer));
-        Status status = receive(buffer, sizeToGet, received);
+        // The size comes from the peer, so the buffer grows only as data
+        // actually arrives, at most PACKET_BUFFER_SIZE past what was received.
+        // It never shrinks, so after the first packets no allocation happens.
+        std::size_t wanted = std::min(static_cast<std::size_t>(packetSize),
+                                      pending_packet_.DataReceived + PACKET_BUFFER_SIZE);
+        if (pending_packet_.Data.size() < wanted)
+            pending_packet_.Data.resize(std::max(wanted, std::min(static_cast<std::size_t>(packetSize),
+                                                                  pending_packet_.Data.size() * 2)));
+        std::size_t room = std::min(pending_packet_.Data.size(), static_cast<std::size_t>(packetSize)) - pending_packet_.DataReceived;
+        char* begin = &pending_packet_.Data[0] + pending_packet_.DataReceived;
+        Status status = receive(begin, room, received);
+        pending_packet_.DataReceived += received;
         if (status != Done)
             return status;
-
-        // Append it into the packet
-        if (received > 0)
-        {
-            pending_packet_.Data.resize(pending_packet_.Data.size() + received);
-            char* begin = &pending_packet_.Data[0] + pending_packet_.Data.size() - received;
-            std::memcpy(begin, buffer, received);
-        }
     }
 
     // We have received all the packet data: we can copy it to the user packet
-    if (!pending_packet_.Data.empty())
-        packet.on_receive(&pending_packet_.Data[0], pending_packet_.Data.size());
+    if (packetSize > 0)
+        packet.on_receive(&pending_packet_.Data[0], packetSize);
 
-    // Clear the pending packet data
-    pending_packet_ = PendingPacket();
+    // Clear the pending packet data, keeping the buffer
+    pending_packet_.Size         = 0;
+    pending_packet_.SizeReceived = 0;
+    pending_packet_.DataReceived = 0;
 
     return Done;
 }
@@ -389,6 +523,7 @@ Socket::Status TcpSocket::receive(Packet& packet)
 TcpSocket::PendingPacket::PendingPacket() :
 Size        (0),
 SizeReceived(0),
+DataReceived(0),
 Data        ()
 {
 
@@ -3,6 +3,7 @@
 #include <MEL/Communications/Socket.hpp>
 #include <MEL/Logging/Log.hpp>
 #include <algorithm>
+#include <cstring>
 
 #ifdef _WIN32
 #include <basetsd.h>
@@ -26,10 +27,18 @@
 #include <unistd.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/uio.h>
 #endif
 
 namespace mel {
 
+namespace {
+
+/// Maximum number of datagrams handed to sendmmsg/recvmmsg per call
+const std::size_t BATCH_SIZE = 64;
+
+} // namespace
+
 //==============================================================================
 // CLASS DEFINITIONS
 //==============================================================================
@@ -136,6 +145,114 @@ Socket::Status UdpSocket::receive(void* data, std::size_t size, std::size_t& rec
     return Done;
 }
 
+Socket::Status UdpSocket::send_batch(const Datagram* datagrams, std::size_t count, std::size_t& sent) {
+    // Create the internal socket if it doesn't exist
+    create();
+    sent = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (datagrams[i].size > MaxDatagramSize) {
+            LOG(mel::Error) << "Cannot send data over the network "
+                << "(the number of bytes to send is greater than mel::UdpSocket::MaxDatagramSize)";
+            return Error;
+        }
+    }
+
+#if defined(__linux__)
+    mmsghdr messages[BATCH_SIZE];
+    iovec vectors[BATCH_SIZE];
+    sockaddr_in addresses[BATCH_SIZE];
+    while (sent < count) {
+        std::size_t n = std::min(count - sent, BATCH_SIZE);
+        for (std::size_t i = 0; i < n; ++i) {
+            const Datagram& datagram = datagrams[sent + i];
+            addresses[i] = Socket::create_address(datagram.address.to_integer(), datagram.port);
+            vectors[i].iov_base = datagram.data;
+            vectors[i].iov_len  = datagram.size;
+            std::memset(&messages[i], 0, sizeof(mmsghdr));
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            messages[i].msg_hdr.msg_iov     = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+        int result = sendmmsg(get_handle(), messages, static_cast<unsigned int>(n), 0);
+        if (result < 0)
+            return Socket::get_error_status();
+        sent += static_cast<std::size_t>(result);
+        // the kernel stops early when a send would fail or block
+        if (static_cast<std::size_t>(result) < n)
+            return Partial;
+    }
+#else
+    for (; sent < count; ++sent) {
+        const Datagram& datagram = datagrams[sent];
+        Status status = send(datagram.data, datagram.size, datagram.address, datagram.port);
+        if (status != Done)
+            return status;
+    }
+#endif
+
+    return Done;
+}
+
+Socket::Status UdpSocket::receive_batch(Datagram* datagrams, std::size_t count, std::size_t& received) {
+    received = 0;
+    if (count == 0)
+        return Done;
+
+#if defined(__linux__)
+    mmsghdr messages[BATCH_SIZE];
+    iovec vectors[BATCH_SIZE];
+    sockaddr_in addresses[BATCH_SIZE];
+    while (received < count) {
+        std::size_t n = std::min(count - received, BATCH_SIZE);
+        for (std::size_t i = 0; i < n; ++i) {
+            Datagram& datagram = datagrams[received + i];
+            vectors[i].iov_base = datagram.data;
+            vectors[i].iov_len  = datagram.size;
+            std::memset(&messages[i], 0, sizeof(mmsghdr));
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            messages[i].msg_hdr.msg_iov     = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+        // block (if blocking) for the first datagram only, then take what is queued
+        int flags = received == 0 ? MSG_WAITFORONE : MSG_DONTWAIT;
+        int result = recvmmsg(get_handle(), messages, static_cast<unsigned int>(n), flags, NULL);
+        if (result < 0)
+            return received > 0 ? Done : Socket::get_error_status();
+        for (int i = 0; i < result; ++i) {
+            Datagram& datagram = datagrams[received + i];
+            datagram.received = messages[i].msg_len;
+            datagram.address  = IpAddress(ntohl(addresses[i].sin_addr.s_addr));
+            datagram.port     = ntohs(addresses[i].sin_port);
+        }
+        received += static_cast<std::size_t>(result);
+        if (static_cast<std::size_t>(result) < n)
+            break;
+    }
+#else
+    Datagram& first = datagrams[0];
+    Status status = receive(first.data, first.size, first.received, first.address, first.port);
+    if (status != Done)
+        return status;
+    received = 1;
+    // take the rest without blocking
+    bool blocking = is_blocking();
+    if (blocking)
+        set_blocking(false);
+    for (; received < count; ++received) {
+        Datagram& datagram = datagrams[received];
+        if (receive(datagram.data, datagram.size, datagram.received, datagram.address, datagram.port) != Done)
+            break;
+    }
+    if (blocking)
+        set_blocking(true);
+#endif
+
+    return Done;
+}
+
 Socket::Status UdpSocket::send(Packet& packet, const IpAddress& remoteAddress, unsigned short remotePort) {
     // UDP is a datagram-oriented protocol (as opposed to TCP which is a stream protocol).
     // Sending one datagram is almost safe: it may be lost but if it's received, then its data
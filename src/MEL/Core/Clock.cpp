@@ -1,4 +1,8 @@
 #include <MEL/Core/Clock.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -8,29 +12,16 @@
 #include <time.h>
 #endif
 
-namespace mel {
-
-//==============================================================================
-// CLASS DEFINITIONS
-//==============================================================================
-
-Clock::Clock() :
-    start_time_(Clock::get_current_time())
-{
-}
-
-Time Clock::get_elapsed_time() const {
-    return Clock::get_current_time() - start_time_;
-}
-
-Time Clock::restart() {
-    Time now = Clock::get_current_time();
-    Time elapsed = now - start_time_;
-    start_time_ = now;
-    return elapsed;
-}
-
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MEL_CLOCK_TSC
+#include <cpuid.h>
+#include <x86intrin.h>
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+#define MEL_CLOCK_TSC
+#include <intrin.h>
+#endif
 
+namespace mel {
 
 //==============================================================================
 // WINDOWS IMPLEMENTATION
@@ -44,15 +35,18 @@ LARGE_INTEGER get_frequency() {
     return frequency;
 }
 
-Time Clock::get_current_time() {
+/// Returns the OS monotonic time in nanoseconds
+static int64 os_time_ns() {
     // Get the frequency of the performance counter
     // (it is constant across the program lifetime)
     static LARGE_INTEGER frequency = get_frequency();
     LARGE_INTEGER time;
    // Get the current time
     QueryPerformanceCounter(&time);
-    // Return the current time as microseconds
-    return mel::microseconds(1000000 * time.QuadPart / frequency.QuadPart);
+    // Split into whole seconds and the rest so the product can't overflow
+    int64 whole = time.QuadPart / frequency.QuadPart;
+    int64 part  = time.QuadPart % frequency.QuadPart;
+    return whole * 1000000000 + part * 1000000000 / frequency.QuadPart;
 }
 
 #elif __APPLE__
@@ -61,12 +55,13 @@ Time Clock::get_current_time() {
 // APPLE IMPLEMENTATION
 //==============================================================================
 
-Time Clock::get_current_time() {
+/// Returns the OS monotonic time in nanoseconds
+static int64 os_time_ns() {
     static mach_timebase_info_data_t frequency = {0, 0};
     if (frequency.denom == 0)
         mach_timebase_info(&frequency);
     uint64 nanoseconds = mach_absolute_time() * frequency.numer / frequency.denom;
-    return mel::microseconds(nanoseconds / 1000);
+    return static_cast<int64>(nanoseconds);
 }
 
 #else
@@ -75,16 +70,149 @@ Time Clock::get_current_time() {
 // LINUX IMPLEMENTATION
 //==============================================================================
 
-Time Clock::get_current_time() {
+/// Returns the OS monotonic time in nanoseconds
+static int64 os_time_ns() {
     // POSIX implementation
     // https://linux.die.net/man/3/clock_gettime
     // https://forums.ni.com/t5/NI-Linux-Real-Time-Discussions/Help-to-solve-a-problem-with-C-on-cRIO-9068/td-p/3469892
     timespec time;
     clock_gettime(CLOCK_MONOTONIC_RAW, &time);
-    return mel::microseconds(static_cast<uint64>(time.tv_sec) * 1000000 + time.tv_nsec / 1000);
+    return static_cast<int64>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+#endif
+
+//==============================================================================
+// TSC IMPLEMENTATION
+//==============================================================================
+
+#ifdef MEL_CLOCK_TSC
+
+namespace {
+
+/// Maps time stamp counter ticks to nanoseconds
+struct TscCalibration {
+    uint64 base_tsc;     ///< counter at base_ns
+    int64 base_ns;       ///< os_time_ns() when calibrated
+    double ns_per_tick;  ///< measured against the reference clock
+};
+
+TscCalibration tsc_calibration = {0, 0, 0.0};
+bool tsc_calibrated = false;
+std::atomic<bool> tsc_enabled(false);
+std::mutex tsc_mutex;
+
+/// How long the counter is measured against the reference clock. The error
+/// of the rate is roughly 100 ns over this time, about 1 ppm.
+const std::chrono::milliseconds TSC_CALIBRATION_TIME(100);
+
+uint64 read_tsc() {
+    return __rdtsc();
 }
 
+/// True if the counter runs at a constant rate in all power states
+bool has_invariant_tsc() {
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuid(regs, 0x80000000);
+    if (static_cast<unsigned int>(regs[0]) < 0x80000007)
+        return false;
+    __cpuid(regs, 0x80000007);
+    return (regs[3] & (1 << 8)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (edx & (1 << 8)) != 0;
 #endif
+}
+
+/// Returns the time of the clock the counter is calibrated against
+int64 reference_ns() {
+#if defined(__linux__)
+    // the NTP disciplined clock, whose rate is the most accurate
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<int64>(time.tv_sec) * 1000000000 + time.tv_nsec;
+#else
+    return os_time_ns();
+#endif
+}
+
+/// Reads the reference clock and the counter at the same instant, taking
+/// the counter halfway through the reference read
+void sample_reference(int64& ns, uint64& tsc) {
+    uint64 before = read_tsc();
+    ns            = reference_ns();
+    uint64 after  = read_tsc();
+    tsc           = before + (after - before) / 2;
+}
+
+int64 tsc_time_ns() {
+    int64 ticks = static_cast<int64>(read_tsc() - tsc_calibration.base_tsc);
+    return tsc_calibration.base_ns + static_cast<int64>(ticks * tsc_calibration.ns_per_tick);
+}
+
+} // namespace
+
+#endif
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
+Clock::Clock() :
+    start_time_(Clock::get_current_time())
+{
+}
+
+Time Clock::get_elapsed_time() const {
+    return Clock::get_current_time() - start_time_;
+}
+
+Time Clock::restart() {
+    Time now = Clock::get_current_time();
+    Time elapsed = now - start_time_;
+    start_time_ = now;
+    return elapsed;
+}
+
+Time Clock::get_current_time() {
+#ifdef MEL_CLOCK_TSC
+    if (tsc_enabled.load(std::memory_order_acquire))
+        return nanoseconds(tsc_time_ns());
+#endif
+    return nanoseconds(os_time_ns());
+}
+
+bool Clock::use_tsc(bool enable) {
+#ifdef MEL_CLOCK_TSC
+    std::lock_guard<std::mutex> lock(tsc_mutex);
+    if (!enable || !has_invariant_tsc()) {
+        tsc_enabled.store(false, std::memory_order_release);
+        return false;
+    }
+    if (!tsc_calibrated) {
+        int64 ns0, ns1;
+        uint64 tsc0, tsc1;
+        sample_reference(ns0, tsc0);
+        std::this_thread::sleep_for(TSC_CALIBRATION_TIME);
+        sample_reference(ns1, tsc1);
+        if (tsc1 <= tsc0 || ns1 <= ns0)
+            return false;
+        tsc_calibration.ns_per_tick = static_cast<double>(ns1 - ns0) / static_cast<double>(tsc1 - tsc0);
+        // continue from the OS clock, so times taken before stay comparable
+        tsc_calibration.base_tsc = read_tsc();
+        tsc_calibration.base_ns  = os_time_ns();
+        tsc_calibrated = true;
+    }
+    tsc_enabled.store(true, std::memory_order_release);
+    return true;
+#else
+    (void)enable;
+    return false;
+#endif
+}
 
 } // namespace mel
 
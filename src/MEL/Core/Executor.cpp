@@ -0,0 +1,256 @@
+#include <MEL/Core/Executor.hpp>
+#include <MEL/Core/Timer.hpp>
+#include <MEL/Logging/Log.hpp>
+#include <MEL/Logging/Table.hpp>
+#include <MEL/Utility/System.hpp>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace mel {
+
+//==============================================================================
+// HELPER FUNCTIONS
+//==============================================================================
+
+namespace {
+
+/// Sets the SCHED_FIFO priority of the calling real-time thread
+bool set_fifo_priority(int priority) {
+#ifdef _WIN32
+    // enable_realtime() already made the thread time critical
+    (void)priority;
+    return true;
+#else
+    sched_param params;
+    params.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &params) == 0;
+#endif
+}
+
+} // namespace
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
+Executor::Executor() :
+    running_(false)
+{ }
+
+Executor::~Executor() {
+    stop();
+}
+
+std::size_t Executor::add_thread(int cpu, int priority) {
+    if (is_running()) {
+        LOG(Warning) << "Executor threads can't be added while running";
+        return static_cast<std::size_t>(-1);
+    }
+    ThreadInfo thread;
+    thread.cpu       = cpu;
+    thread.priority  = priority;
+    thread.period_ns = 0;
+    threads_.push_back(thread);
+    return threads_.size() - 1;
+}
+
+std::size_t Executor::add_task(const std::string& name, Time period, Task task, std::size_t thread) {
+    if (is_running()) {
+        LOG(Warning) << "Executor task " << name << " can't be added while running";
+        return static_cast<std::size_t>(-1);
+    }
+    while (threads_.size() <= thread)
+        add_thread();
+    TaskInfo info;
+    info.name      = name;
+    info.period_ns = std::max<int64>(period.as_nanoseconds(), 1);
+    info.task      = task;
+    info.thread    = thread;
+    info.divider   = 1;
+    info.runs      = 0;
+    info.overruns  = 0;
+    tasks_.push_back(info);
+    return tasks_.size() - 1;
+}
+
+std::size_t Executor::add_task(const std::string& name, Frequency rate, Task task, std::size_t thread) {
+    return add_task(name, rate.to_time(), task, thread);
+}
+
+bool Executor::start() {
+    if (is_running()) {
+        LOG(Warning) << "Executor already running";
+        return false;
+    }
+    if (tasks_.empty()) {
+        LOG(Warning) << "Executor has no tasks to run";
+        return false;
+    }
+    plan();
+    running_ = true;
+    for (std::size_t i = 0; i < threads_.size(); ++i) {
+        if (!threads_[i].tasks.empty())
+            workers_.push_back(std::thread(&Executor::thread_func, this, i));
+    }
+    return true;
+}
+
+void Executor::stop() {
+    running_ = false;
+    for (std::size_t i = 0; i < workers_.size(); ++i)
+        workers_[i].join();
+    workers_.clear();
+}
+
+bool Executor::is_running() const {
+    return running_;
+}
+
+std::size_t Executor::get_task_count() const {
+    return tasks_.size();
+}
+
+const std::string& Executor::get_task_name(std::size_t task) const {
+    return tasks_[task].name;
+}
+
+Time Executor::get_task_period(std::size_t task) const {
+    const TaskInfo& info = tasks_[task];
+    int64 tick = threads_[info.thread].period_ns;
+    return nanoseconds(tick > 0 ? tick * info.divider : info.period_ns);
+}
+
+const Histogram& Executor::get_execution_time(std::size_t task) const {
+    return tasks_[task].execution_time;
+}
+
+const Histogram& Executor::get_response_time(std::size_t task) const {
+    return tasks_[task].response_time;
+}
+
+int64 Executor::get_run_count(std::size_t task) const {
+    return tasks_[task].runs;
+}
+
+int64 Executor::get_overrun_count(std::size_t task) const {
+    return tasks_[task].overruns;
+}
+
+void Executor::reset_stats() {
+    for (std::size_t i = 0; i < tasks_.size(); ++i) {
+        tasks_[i].execution_time.reset();
+        tasks_[i].response_time.reset();
+        tasks_[i].runs     = 0;
+        tasks_[i].overruns = 0;
+    }
+}
+
+Table Executor::get_stats_table() const {
+    std::vector<std::string> col_names;
+    col_names.push_back("period_us");
+    col_names.push_back("runs");
+    col_names.push_back("overruns");
+    col_names.push_back("execution_p50_us");
+    col_names.push_back("execution_p99_us");
+    col_names.push_back("execution_max_us");
+    col_names.push_back("response_p99_us");
+    col_names.push_back("response_max_us");
+    Table table("executor_stats", col_names);
+    std::vector<double> row(col_names.size());
+    for (std::size_t i = 0; i < tasks_.size(); ++i) {
+        const TaskInfo& info = tasks_[i];
+        row[0] = get_task_period(i).as_nanoseconds() * 1e-3;
+        row[1] = static_cast<double>(info.runs);
+        row[2] = static_cast<double>(info.overruns);
+        row[3] = info.execution_time.get_percentile(50) * 1e-3;
+        row[4] = info.execution_time.get_percentile(99) * 1e-3;
+        row[5] = info.execution_time.get_max() * 1e-3;
+        row[6] = info.response_time.get_percentile(99) * 1e-3;
+        row[7] = info.response_time.get_max() * 1e-3;
+        table.push_back_row(row);
+    }
+    return table;
+}
+
+void Executor::plan() {
+    for (std::size_t i = 0; i < threads_.size(); ++i) {
+        threads_[i].tasks.clear();
+        threads_[i].period_ns = 0;
+    }
+    for (std::size_t i = 0; i < tasks_.size(); ++i)
+        threads_[tasks_[i].thread].tasks.push_back(i);
+    for (std::size_t i = 0; i < threads_.size(); ++i) {
+        ThreadInfo& thread = threads_[i];
+        if (thread.tasks.empty())
+            continue;
+        // rate monotonic: the shortest period runs first on each tick
+        std::stable_sort(thread.tasks.begin(), thread.tasks.end(),
+            [this](std::size_t a, std::size_t b) { return tasks_[a].period_ns < tasks_[b].period_ns; });
+        thread.period_ns = tasks_[thread.tasks[0]].period_ns;
+        for (std::size_t j = 0; j < thread.tasks.size(); ++j) {
+            TaskInfo& task = tasks_[thread.tasks[j]];
+            task.divider = (task.period_ns + thread.period_ns / 2) / thread.period_ns;
+            if (task.divider * thread.period_ns != task.period_ns) {
+                LOG(Warning) << "Executor task " << task.name << " period " << nanoseconds(task.period_ns)
+                             << " rounded to " << nanoseconds(task.divider * thread.period_ns);
+            }
+        }
+    }
+}
+
+void Executor::thread_func(std::size_t index) {
+    const ThreadInfo& thread = threads_[index];
+    if (thread.cpu >= 0 && !set_thread_affinity(thread.cpu)) {
+        LOG(Warning) << "Executor thread " << index << " could not be pinned to CPU " << thread.cpu;
+    }
+    if (enable_realtime()) {
+        int priority = thread.priority;
+#ifndef _WIN32
+        if (priority < 0) {
+            // one level below max for each thread with a faster tick
+            int max = sched_get_priority_max(SCHED_FIFO);
+            int min = sched_get_priority_min(SCHED_FIFO);
+            int rank = 0;
+            for (std::size_t i = 0; i < threads_.size(); ++i) {
+                if (!threads_[i].tasks.empty() && threads_[i].period_ns < thread.period_ns)
+                    rank += 1;
+            }
+            priority = std::max(max - rank, min);
+        }
+#endif
+        if (priority >= 0 && !set_fifo_priority(priority)) {
+            LOG(Warning) << "Executor thread " << index << " could not be given priority " << priority;
+        }
+    }
+    else {
+        LOG(Warning) << "Executor thread " << index << " is not real-time";
+    }
+
+    Timer timer(nanoseconds(thread.period_ns), Timer::Deadline);
+    while (running_.load(std::memory_order_relaxed)) {
+        int64 tick    = timer.get_elapsed_ticks();
+        // all times on the clock the Timer's deadlines are kept on, so the
+        // response time doesn't drift with the rate of another clock
+        int64 release = timer.get_tick_deadline().as_nanoseconds();
+        for (std::size_t i = 0; i < thread.tasks.size(); ++i) {
+            TaskInfo& task = tasks_[thread.tasks[i]];
+            if (tick % task.divider != 0)
+                continue;
+            int64 start = Timer::get_monotonic_time().as_nanoseconds();
+            task.task();
+            int64 end = Timer::get_monotonic_time().as_nanoseconds();
+            task.execution_time.record(end - start);
+            task.response_time.record(end - release);
+            task.runs += 1;
+            if (end - release > task.divider * thread.period_ns)
+                task.overruns += 1;
+        }
+        timer.wait();
+    }
+}
+
+} // namespace mel
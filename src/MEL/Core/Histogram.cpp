@@ -0,0 +1,147 @@
+#include <MEL/Core/Histogram.hpp>
+#include <MEL/Logging/Table.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace mel {
+
+//==============================================================================
+// HELPER FUNCTIONS
+//==============================================================================
+
+namespace {
+
+/// Number of buckets below 2^SUB_BUCKET_BITS, one per value
+const int64 SUB_BUCKETS = int64(1) << Histogram::SUB_BUCKET_BITS;
+
+/// Buckets per power of two above SUB_BUCKETS
+const int64 HALF_BUCKETS = SUB_BUCKETS / 2;
+
+/// Returns the index of the highest set bit of #value, which is not 0
+int highest_bit(uint64 value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1)
+        ++bit;
+    return bit;
+#endif
+}
+
+} // namespace
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
+const int Histogram::SUB_BUCKET_BITS;
+const int64 Histogram::MAX_VALUE;
+const std::size_t Histogram::BUCKET_COUNT;
+
+Histogram::Histogram() {
+    reset();
+}
+
+void Histogram::record(int64 value) {
+    value = std::min(std::max<int64>(value, 0), MAX_VALUE);
+    counts_[bucket_index(value)] += 1;
+    if (count_ == 0 || value < min_)
+        min_ = value;
+    if (value > max_)
+        max_ = value;
+    count_ += 1;
+    sum_ += static_cast<double>(value);
+}
+
+void Histogram::reset() {
+    std::memset(counts_, 0, sizeof(counts_));
+    count_ = 0;
+    min_   = 0;
+    max_   = 0;
+    sum_   = 0;
+}
+
+uint64 Histogram::get_count() const {
+    return count_;
+}
+
+int64 Histogram::get_min() const {
+    return min_;
+}
+
+int64 Histogram::get_max() const {
+    return max_;
+}
+
+double Histogram::get_mean() const {
+    return count_ > 0 ? sum_ / static_cast<double>(count_) : 0.0;
+}
+
+int64 Histogram::get_percentile(double percentile) const {
+    if (count_ == 0)
+        return 0;
+    if (percentile <= 0.0)
+        return min_;
+    // the rank of the value, counting from 1
+    double rank = std::ceil(std::min(percentile, 100.0) / 100.0 * static_cast<double>(count_));
+    uint64 target = std::max<uint64>(static_cast<uint64>(rank), 1);
+    uint64 seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts_[i];
+        if (seen >= target)
+            return std::min(bucket_upper(i), max_);
+    }
+    return max_;
+}
+
+Table Histogram::to_table(const std::string& name) const {
+    std::vector<std::string> col_names;
+    col_names.push_back("value");
+    col_names.push_back("count");
+    col_names.push_back("percentile");
+    Table table(name, col_names);
+    std::vector<double> row(3);
+    uint64 seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        if (counts_[i] == 0)
+            continue;
+        seen += counts_[i];
+        row[0] = static_cast<double>(std::min(bucket_upper(i), max_));
+        row[1] = static_cast<double>(counts_[i]);
+        row[2] = 100.0 * static_cast<double>(seen) / static_cast<double>(count_);
+        table.push_back_row(row);
+    }
+    return table;
+}
+
+std::size_t Histogram::bucket_index(int64 value) {
+    if (value < SUB_BUCKETS)
+        return static_cast<std::size_t>(std::max<int64>(value, 0));
+    value = std::min(value, MAX_VALUE);
+    int bit   = highest_bit(static_cast<uint64>(value));
+    int shift = bit - SUB_BUCKET_BITS + 1;
+    // value >> shift is in [HALF_BUCKETS, SUB_BUCKETS)
+    return static_cast<std::size_t>(SUB_BUCKETS + (bit - SUB_BUCKET_BITS) * HALF_BUCKETS + (value >> shift) - HALF_BUCKETS);
+}
+
+int64 Histogram::bucket_lower(std::size_t index) {
+    if (static_cast<int64>(index) < SUB_BUCKETS)
+        return static_cast<int64>(index);
+    int64 offset = static_cast<int64>(index) - SUB_BUCKETS;
+    int bit      = static_cast<int>(offset / HALF_BUCKETS) + SUB_BUCKET_BITS;
+    int64 mantissa = offset % HALF_BUCKETS + HALF_BUCKETS;
+    return mantissa << (bit - SUB_BUCKET_BITS + 1);
+}
+
+int64 Histogram::bucket_upper(std::size_t index) {
+    if (static_cast<int64>(index) < SUB_BUCKETS)
+        return static_cast<int64>(index);
+    int64 offset = static_cast<int64>(index) - SUB_BUCKETS;
+    int bit      = static_cast<int>(offset / HALF_BUCKETS) + SUB_BUCKET_BITS;
+    int64 mantissa = offset % HALF_BUCKETS + HALF_BUCKETS;
+    return ((mantissa + 1) << (bit - SUB_BUCKET_BITS + 1)) - 1;
+}
+
+} // namespace mel
@@ -2,6 +2,13 @@
 #include <MEL/Utility/System.hpp>
 #include <MEL/Core/Console.hpp>
 #include <MEL/Logging/Log.hpp>
+#include <MEL/Logging/Table.hpp>
+#include <algorithm>
+
+#ifdef __linux__
+#include <errno.h>
+#include <time.h>
+#endif
 
 namespace mel {
 
@@ -16,6 +23,35 @@ static void wait_sleep(const Time& duration) {
     sleep(duration);
 }
 
+/// Returns the time in nanoseconds on the clock Deadline Timers sleep against
+static int64 monotonic_ns() {
+#ifdef __linux__
+    // CLOCK_MONOTONIC rather than Clock's CLOCK_MONOTONIC_RAW, because
+    // clock_nanosleep() does not accept the raw clock
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<int64>(time.tv_sec) * 1000000000 + time.tv_nsec;
+#else
+    return Clock::get_current_time().as_nanoseconds();
+#endif
+}
+
+/// Sleeps until monotonic_ns() reaches #deadline
+static void sleep_until_ns(int64 deadline) {
+#ifdef __linux__
+    timespec time;
+    time.tv_sec  = static_cast<time_t>(deadline / 1000000000);
+    time.tv_nsec = static_cast<long>(deadline % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, NULL) == EINTR) {
+        // interrupted by a signal, the deadline is still the same
+    }
+#else
+    int64 remaining = deadline - monotonic_ns();
+    if (remaining > 0)
+        sleep(nanoseconds(remaining));
+#endif
+}
+
 Timer::Timer(Frequency frequency, WaitMode mode) :
     Timer(frequency.to_time(), mode)
 {
@@ -26,7 +62,14 @@ Timer::Timer(Time period, WaitMode mode) :
     clock_(Clock()),
     period_(period),
     ticks_(0),
-    prev_time_(Clock::get_current_time())
+    prev_time_(Clock::get_current_time()),
+    miss_policy_(CatchUp),
+    start_ns_(monotonic_ns()),
+    max_spin_ns_(0),
+    wake_latency_ns_(0),
+    tick_start_ns_(start_ns_),
+    tick_deadline_ns_(start_ns_),
+    overruns_(0)
 {
 }
 
@@ -35,12 +78,27 @@ Timer::~Timer() { }
 Time Timer::restart() {
     ticks_ = 0;
     prev_time_ = Clock::get_current_time();
+    start_ns_ = monotonic_ns();
+    tick_start_ns_ = start_ns_;
+    tick_deadline_ns_ = start_ns_;
     return clock_.restart();
 }
 
 Time Timer::wait() {
+    int64 entry = monotonic_ns();
+    compute_time_.record(entry - tick_start_ns_);
+    if (mode_ == WaitMode::Deadline) {
+        int64 deadline = wait_deadline(entry);
+        tick_deadline_ns_ = deadline;
+        tick_start_ns_ = monotonic_ns();
+        wake_latency_.record(tick_start_ns_ - deadline);
+        prev_time_ = Clock::get_current_time();
+        return get_elapsed_time();
+    }
+    int64 deadline = tick_start_ns_ + period_.as_nanoseconds();
     Time remaining_time = period_ - (Clock::get_current_time() - prev_time_);
     if (remaining_time < Time::Zero) {
+        overruns_ += 1;
         LOG_IF(Verbose, ticks_ > 0) << "Timer with period " << period_ << " missed deadline by " << -remaining_time << " on tick number " << ticks_;
     }
     else {
@@ -54,6 +112,9 @@ Time Timer::wait() {
             wait_busy(remaining_time);
         }
     }
+    tick_deadline_ns_ = deadline;
+    tick_start_ns_ = monotonic_ns();
+    wake_latency_.record(tick_start_ns_ - deadline);
     prev_time_ = Clock::get_current_time();
     ticks_ += 1;
     return get_elapsed_time();
@@ -67,6 +128,14 @@ Time Timer::get_elapsed_time() {
     return period_ * ticks_;
 }
 
+Time Timer::get_tick_deadline() const {
+    return nanoseconds(tick_deadline_ns_);
+}
+
+Time Timer::get_monotonic_time() {
+    return nanoseconds(monotonic_ns());
+}
+
 int64 Timer::get_elapsed_ticks() {
     return ticks_;
 }
@@ -79,6 +148,82 @@ Time Timer::get_period() {
     return period_;
 }
 
+void Timer::set_miss_policy(MissPolicy policy) {
+    miss_policy_ = policy;
+}
+
+void Timer::set_spin_time(Time max_spin) {
+    max_spin_ns_ = std::max<int64>(max_spin.as_nanoseconds(), 0);
+}
+
+const Histogram& Timer::get_wake_latency() const {
+    return wake_latency_;
+}
+
+const Histogram& Timer::get_compute_time() const {
+    return compute_time_;
+}
+
+int64 Timer::get_overrun_count() const {
+    return overruns_;
+}
+
+void Timer::reset_stats() {
+    wake_latency_.reset();
+    compute_time_.reset();
+    overruns_ = 0;
+}
+
+Table Timer::get_stats_table() const {
+    std::vector<std::string> col_names;
+    col_names.push_back("percentile");
+    col_names.push_back("wake_latency_us");
+    col_names.push_back("compute_time_us");
+    Table table("timer_stats", col_names);
+    const double percentiles[] = {50, 90, 99, 99.9, 99.99, 100};
+    std::vector<double> row(3);
+    for (std::size_t i = 0; i < sizeof(percentiles) / sizeof(double); ++i) {
+        row[0] = percentiles[i];
+        row[1] = wake_latency_.get_percentile(percentiles[i]) * 1e-3;
+        row[2] = compute_time_.get_percentile(percentiles[i]) * 1e-3;
+        table.push_back_row(row);
+    }
+    return table;
+}
+
+int64 Timer::wait_deadline(int64 now) {
+    int64 period   = period_.as_nanoseconds();
+    int64 deadline = start_ns_ + (ticks_ + 1) * period;
+    if (now >= deadline) {
+        overruns_ += 1;
+        LOG_IF(Verbose, ticks_ > 0) << "Timer with period " << period_ << " missed deadline by " << nanoseconds(now - deadline) << " on tick number " << ticks_;
+        if (miss_policy_ == CatchUp || period <= 0) {
+            ticks_ += 1;
+            return deadline;
+        }
+        // the next deadline on the original schedule, so the phase is kept
+        ticks_   = (now - start_ns_) / period;
+        deadline = start_ns_ + (ticks_ + 1) * period;
+    }
+    int64 spin = std::min(max_spin_ns_, wake_latency_ns_);
+    int64 wake = deadline - spin;
+    if (wake > now) {
+        sleep_until_ns(wake);
+        // jumps up to new highs at once and decays slowly, so the spin
+        // covers nearly every late wakeup
+        int64 late = std::max<int64>(monotonic_ns() - wake, 0);
+        if (late > wake_latency_ns_)
+            wake_latency_ns_ = late;
+        else
+            wake_latency_ns_ -= (wake_latency_ns_ - late) / 64;
+    }
+    while (monotonic_ns() < deadline) {
+        // spin out the calibrated tail
+    }
+    ticks_ += 1;
+    return deadline;
+}
+
 
 
 } // namespace mel
@@ -58,6 +58,21 @@ Timestamp::Timestamp() {
 }
 #endif
 
+Timestamp::Timestamp(long long microseconds) {
+    time_t seconds = static_cast<time_t>(microseconds / 1000000);
+    tm t;
+    mel::localtime_s(&t, &seconds);
+    year     = t.tm_year + 1900;
+    month    = t.tm_mon + 1;
+    yday     = t.tm_yday + 1;
+    mday     = t.tm_mday;
+    wday     = t.tm_wday + 1;
+    hour     = t.tm_hour;
+    min      = t.tm_min;
+    sec      = t.tm_sec;
+    millisec = static_cast<int>(microseconds % 1000000 / 1000);
+}
+
 std::string Timestamp::yyyy_mm_dd() const {
     std::ostringstream ss;
     ss << year << "-"
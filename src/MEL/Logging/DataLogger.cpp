@@ -2,12 +2,816 @@
 #include <MEL/Logging/Log.hpp>
 #include <MEL/Utility/System.hpp>
 #include <MEL/Logging/File.hpp>
+#include <MEL/Core/NonCopyable.hpp>
+#include <MEL/Core/Types.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
-#include <fstream>
 #include <thread>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace mel {
 
+//==============================================================================
+// BINARY LOG FORMAT
+//==============================================================================
+
+// A MEL binary log is a header followed by row-major rows. Everything is
+// stored in the byte order of the host that wrote it, with a raw memcpy:
+//
+//   char[8] magic "MELLOG\0\0"
+//   uint32  version
+//   uint32  column count
+//   uint32  header size in bytes (offset of the first row, multiple of 8)
+//   uint32  zero padding
+//   uint64  committed file length in bytes, header included
+//   uint32  name length, then the name characters
+//   per column: uint32 type (0 = float64, 1 = float32), uint32 name length,
+//               then the name characters
+//   zero padding up to the header size
+//   rows of column values, each stored in its column's type
+//
+// The row count follows from the committed length, which MappedFile updates
+// once the rows it covers are on disk. A log left open by a crash keeps its
+// preallocated zero tail; readers and reopen() ignore the bytes past the
+// committed length instead of taking zero rows from the tail for data.
+// Version 1 logs have no length field and are read up to the file size.
+//
+// The version doubles as a byte order mark: on a host of the other byte
+// order it reads byte swapped, and the log is rejected as such rather than
+// decoded into garbage.
+
+namespace {
+
+const char   BIN_MAGIC[8] = {'M', 'E', 'L', 'L', 'O', 'G', '\0', '\0'};
+const uint32 BIN_VERSION  = 2;
+const std::size_t BIN_LENGTH_OFFSET = 24;
+const uint32 BIN_FLOAT64  = 0;
+const uint32 BIN_FLOAT32  = 1;
+
+/// Parsed binary log header
+struct BinHeader {
+    std::string name;
+    std::vector<std::string> col_names;
+    std::vector<uint32> col_types;
+    uint32 version;
+    std::size_t data_offset;  ///< offset of the first row
+    std::size_t data_end;     ///< end of the committed rows, at most the file size
+    std::size_t row_bytes;    ///< size of one row
+
+    /// Returns the number of whole rows committed
+    std::size_t row_count() const {
+        return row_bytes == 0 ? 0 : (data_end - data_offset) / row_bytes;
+    }
+};
+
+void append_uint32(std::string& out, uint32 value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void append_string(std::string& out, const std::string& str) {
+    append_uint32(out, static_cast<uint32>(str.size()));
+    out.append(str);
+}
+
+/// Builds the header of a binary log that will hold #row_count rows
+std::string make_bin_header(const std::string& name, const std::vector<std::string>& col_names, std::size_t col_count, FileFormat format, std::size_t row_count = 0) {
+    uint32 type = format == FileFormat::Binary32 ? BIN_FLOAT32 : BIN_FLOAT64;
+    std::string out(BIN_MAGIC, sizeof(BIN_MAGIC));
+    append_uint32(out, BIN_VERSION);
+    append_uint32(out, static_cast<uint32>(col_count));
+    append_uint32(out, 0);  // header size, patched below
+    append_uint32(out, 0);
+    out.append(sizeof(uint64), '\0');  // committed length, patched below
+    append_string(out, name);
+    for (std::size_t i = 0; i < col_count; ++i) {
+        append_uint32(out, type);
+        append_string(out, i < col_names.size() ? col_names[i] : std::string());
+    }
+    out.resize((out.size() + 7) / 8 * 8, '\0');
+    uint32 size = static_cast<uint32>(out.size());
+    std::memcpy(&out[sizeof(BIN_MAGIC) + 2 * sizeof(uint32)], &size, sizeof(size));
+    std::size_t value_bytes = format == FileFormat::Binary32 ? sizeof(float) : sizeof(double);
+    uint64 length = size + row_count * col_count * value_bytes;
+    std::memcpy(&out[BIN_LENGTH_OFFSET], &length, sizeof(length));
+    return out;
+}
+
+/// Appends #row as a binary row of exactly #col_count values, the count in
+/// the file's header, padding with zeros or truncating so later rows stay
+/// aligned
+void append_bin_row(std::string& out, const double* row, std::size_t size, std::size_t col_count, FileFormat format) {
+    std::size_t n = std::min(size, col_count);
+    if (format == FileFormat::Binary32) {
+        for (std::size_t i = 0; i < n; ++i) {
+            float value = static_cast<float>(row[i]);
+            out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        out.append((col_count - n) * sizeof(float), '\0');
+    }
+    else {
+        out.append(reinterpret_cast<const char*>(row), n * sizeof(double));
+        out.append((col_count - n) * sizeof(double), '\0');
+    }
+}
+
+bool read_uint32(const char* data, std::size_t size, std::size_t& pos, uint32& value) {
+    if (pos + sizeof(uint32) > size)
+        return false;
+    std::memcpy(&value, data + pos, sizeof(uint32));
+    pos += sizeof(uint32);
+    return true;
+}
+
+bool read_string(const char* data, std::size_t size, std::size_t& pos, std::string& str) {
+    uint32 length;
+    if (!read_uint32(data, size, pos, length) || pos + length > size)
+        return false;
+    str.assign(data + pos, length);
+    pos += length;
+    return true;
+}
+
+bool parse_bin_header(const char* data, std::size_t size, BinHeader& header) {
+    if (size < sizeof(BIN_MAGIC) || std::memcmp(data, BIN_MAGIC, sizeof(BIN_MAGIC)) != 0)
+        return false;
+    std::size_t pos = sizeof(BIN_MAGIC);
+    uint32 version, col_count, header_size;
+    if (!read_uint32(data, size, pos, version) || (version != 1 && version != BIN_VERSION) ||
+        !read_uint32(data, size, pos, col_count) ||
+        !read_uint32(data, size, pos, header_size) || header_size > size)
+        return false;
+    header.version  = version;
+    header.data_end = size;
+    if (version >= 2) {
+        uint64 length;
+        if (BIN_LENGTH_OFFSET + sizeof(length) > size)
+            return false;
+        std::memcpy(&length, data + BIN_LENGTH_OFFSET, sizeof(length));
+        if (length < header_size)
+            return false;
+        header.data_end = static_cast<std::size_t>(std::min<uint64>(length, size));
+        pos = BIN_LENGTH_OFFSET + sizeof(length);
+    }
+    if (!read_string(data, size, pos, header.name))
+        return false;
+    // each column takes at least a type and a name length, so a corrupt
+    // count can't make us allocate more than the file could describe
+    if (col_count > (size - pos) / (2 * sizeof(uint32)))
+        return false;
+    header.col_names.resize(col_count);
+    header.col_types.resize(col_count);
+    header.row_bytes = 0;
+    for (uint32 i = 0; i < col_count; ++i) {
+        if (!read_uint32(data, size, pos, header.col_types[i]) ||
+            !read_string(data, size, pos, header.col_names[i]))
+            return false;
+        if (header.col_types[i] == BIN_FLOAT64)
+            header.row_bytes += sizeof(double);
+        else if (header.col_types[i] == BIN_FLOAT32)
+            header.row_bytes += sizeof(float);
+        else
+            return false;
+    }
+    header.data_offset = header_size;
+    return pos <= header_size;
+}
+
+/// Decodes one row of a binary log into #row
+void decode_bin_row(const char* data, const BinHeader& header, double* row) {
+    for (std::size_t j = 0; j < header.col_types.size(); ++j) {
+        if (header.col_types[j] == BIN_FLOAT64) {
+            std::memcpy(&row[j], data, sizeof(double));
+            data += sizeof(double);
+        }
+        else {
+            float value;
+            std::memcpy(&value, data, sizeof(float));
+            row[j] = value;
+            data += sizeof(float);
+        }
+    }
+}
+
+/// Read only memory map of a whole file
+class MappedInput {
+public:
+    MappedInput(const std::string& filename) : data_(NULL), size_(0), open_(false) {
+#ifdef _WIN32
+        file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        mapping_ = NULL;
+        if (file_ == INVALID_HANDLE_VALUE)
+            return;
+        open_ = true;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0)
+            return;
+        mapping_ = CreateFileMappingA(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping_ == NULL)
+            return;
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_)
+            size_ = static_cast<std::size_t>(size.QuadPart);
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        open_ = true;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* data = mmap(NULL, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                data_ = static_cast<const char*>(data);
+                size_ = static_cast<std::size_t>(st.st_size);
+                // rows are read front to back exactly once
+                madvise(data, size_, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+#endif
+    }
+
+    ~MappedInput() {
+#ifdef _WIN32
+        if (data_)
+            UnmapViewOfFile(data_);
+        if (mapping_)
+            CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE)
+            CloseHandle(file_);
+#else
+        if (data_)
+            munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    /// True if the file exists, even when it is empty and data() is NULL
+    bool is_open() const { return open_; }
+
+private:
+    const char* data_;
+    std::size_t size_;
+    bool open_;
+#ifdef _WIN32
+    HANDLE file_;
+    HANDLE mapping_;
+#endif
+};
+
+/// Parses the header of the binary log in #file, logging why it can't be
+/// read on failure. #caller names the DataLogger function in the log.
+bool read_bin_header(const MappedInput& file, BinHeader& header, const char* caller) {
+    if (!file.is_open()) {
+        LOG(Warning) << "File not found in DataLogger::" << caller << "().";
+        return false;
+    }
+    if (file.size() < BIN_LENGTH_OFFSET) {
+        LOG(Warning) << "File is empty or too short to hold a MEL binary log header in DataLogger::" << caller << "().";
+        return false;
+    }
+    if (std::memcmp(file.data(), BIN_MAGIC, sizeof(BIN_MAGIC)) != 0) {
+        LOG(Warning) << "File is not a MEL binary log in DataLogger::" << caller << "().";
+        return false;
+    }
+    uint32 version;
+    std::memcpy(&version, file.data() + sizeof(BIN_MAGIC), sizeof(version));
+    uint32 swapped = (version >> 24) | ((version >> 8) & 0xFF00) | ((version << 8) & 0xFF0000) | (version << 24);
+    if (version != swapped && (swapped == 1 || swapped == BIN_VERSION)) {
+        LOG(Warning) << "File is a MEL binary log written on a host of the other byte order in DataLogger::" << caller << "().";
+        return false;
+    }
+    if (!parse_bin_header(file.data(), file.size(), header)) {
+        LOG(Warning) << "File has a truncated or invalid MEL binary log header in DataLogger::" << caller << "().";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+//==============================================================================
+// CSV TEXT
+//==============================================================================
+
+namespace {
+
+/// Returns the printf conversion that matches an ostream set to #format
+const char* csv_spec(DataFormat format) {
+    if (format == DataFormat::Fixed)
+        return "%.*f";
+    if (format == DataFormat::Scientific)
+        return "%.*e";
+    return "%.*g";
+}
+
+#if defined(__SIZEOF_INT128__)
+
+typedef unsigned __int128 uint128;
+
+/// Powers of ten up to 10^38, the largest below 2^128
+struct Pow10Table {
+    Pow10Table() {
+        value[0] = 1;
+        for (int i = 1; i < 39; ++i)
+            value[i] = value[i - 1] * 10;
+    }
+    uint128 value[39];
+};
+
+const uint128* pow10_128() {
+    static const Pow10Table table;
+    return table.value;
+}
+
+/// Returns the number of significant bits in #x
+inline int bit_length(uint128 x) {
+    uint64 hi = static_cast<uint64>(x >> 64);
+    if (hi)
+        return 128 - __builtin_clzll(hi);
+    uint64 lo = static_cast<uint64>(x);
+    return lo ? 64 - __builtin_clzll(lo) : 0;
+}
+
+/// Rounds mantissa * 2^exp2 * 10^scale to the nearest integer, ties to even,
+/// which is exactly how printf rounds. Returns false if the exact
+/// intermediate values or the result do not fit.
+bool scale_round(uint64 mantissa, int exp2, int scale, uint64& result) {
+    if (mantissa == 0) {
+        result = 0;
+        return true;
+    }
+    if (scale > 38 || scale < -38)
+        return false;
+    const uint128* pow10 = pow10_128();
+    uint128 num = mantissa;
+    uint128 den = 1;
+    if (scale >= 0) {
+        if (bit_length(num) + bit_length(pow10[scale]) > 127)
+            return false;
+        num *= pow10[scale];
+    }
+    else {
+        den = pow10[-scale];
+    }
+    uint128 q, r;
+    bool round_up;
+    if (exp2 >= 0) {
+        if (bit_length(num) + exp2 > 127)
+            return false;
+        num <<= exp2;
+        q = num / den;
+        r = num % den;
+        round_up = 2 * r > den || (2 * r == den && (q & 1));
+    }
+    else if (den == 1) {
+        // dividing by a power of two is a shift
+        int shift = -exp2;
+        if (shift > 127) {
+            result = 0;  // num < 2^127, so below one half
+            return true;
+        }
+        uint128 half = static_cast<uint128>(1) << (shift - 1);
+        q = num >> shift;
+        r = num & ((half << 1) - 1);
+        round_up = r > half || (r == half && (q & 1));
+    }
+    else {
+        if (bit_length(den) - exp2 > 127)
+            return false;
+        den <<= -exp2;
+        q = num / den;
+        r = num % den;
+        round_up = 2 * r > den || (2 * r == den && (q & 1));
+    }
+    q += round_up;
+    if (q >> 64)
+        return false;
+    result = static_cast<uint64>(q);
+    return true;
+}
+
+/// Writes the decimal digits of #n, left padded with zeros to #width
+inline char* write_digits(char* out, uint64 n, int width) {
+    char digits[24];
+    int len = 0;
+    do {
+        digits[len++] = static_cast<char>('0' + n % 10);
+        n /= 10;
+    } while (n);
+    while (len < width)
+        digits[len++] = '0';
+    while (len)
+        *out++ = digits[--len];
+    return out;
+}
+
+/// Writes n * 10^-decimals with #decimals digits after the point
+char* write_fixed(char* out, uint64 n, int decimals) {
+    char digits[48];
+    char* end = write_digits(digits, n, decimals + 1);
+    std::size_t whole = end - digits - decimals;
+    std::memcpy(out, digits, whole);
+    out += whole;
+    if (decimals > 0) {
+        *out++ = '.';
+        std::memcpy(out, digits + whole, decimals);
+        out += decimals;
+    }
+    return out;
+}
+
+/// Removes the zeros, then the point, that end a fraction in [begin, end)
+char* strip_zeros(char* begin, char* end) {
+    if (!std::memchr(begin, '.', end - begin))
+        return end;
+    while (end[-1] == '0')
+        --end;
+    if (end[-1] == '.')
+        --end;
+    return end;
+}
+
+/// Writes the exponent of a scientific number, e.g. e+05
+char* write_exponent(char* out, int exp10) {
+    *out++ = 'e';
+    *out++ = exp10 < 0 ? '-' : '+';
+    return write_digits(out, static_cast<uint64>(exp10 < 0 ? -exp10 : exp10), 2);
+}
+
+/// Formats #value into #out exactly like snprintf with csv_spec(#format) and
+/// #precision. Finite values up to 17 digits of precision are converted with
+/// 128 bit integer arithmetic, several times faster than printf; the rest,
+/// and anything that would not fit, is left to snprintf.
+int format_double(char* out, std::size_t size, DataFormat format, int precision, double value) {
+    if (size < 64 || precision < 0 || precision > 17 || !std::isfinite(value))
+        return std::snprintf(out, size, csv_spec(format), precision, value);
+    uint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint64 mantissa = bits & ((static_cast<uint64>(1) << 52) - 1);
+    int biased = static_cast<int>((bits >> 52) & 0x7ff);
+    int exp2 = biased == 0 ? -1074 : biased - 1075;
+    if (biased != 0)
+        mantissa |= static_cast<uint64>(1) << 52;
+    char* p = out;
+    if (bits >> 63)
+        *p++ = '-';
+    uint64 n;
+    if (format == DataFormat::Fixed) {
+        if (!scale_round(mantissa, exp2, precision, n))
+            return std::snprintf(out, size, csv_spec(format), precision, value);
+        p = write_fixed(p, n, precision);
+        *p = '\0';
+        return static_cast<int>(p - out);
+    }
+    // significant digits, and the power of ten of the first, after rounding
+    int digits = format == DataFormat::Scientific ? precision + 1 : (precision == 0 ? 1 : precision);
+    int exp10 = 0;
+    n = 0;
+    if (mantissa != 0) {
+        // floor(log10(value)) or one less
+        exp10 = static_cast<int>(std::floor((exp2 + 63 - __builtin_clzll(mantissa)) * 0.30102999566398119521));
+        const uint128* pow10 = pow10_128();
+        for (int attempt = 0;; ++attempt) {
+            if (attempt == 3 || !scale_round(mantissa, exp2, digits - 1 - exp10, n))
+                return std::snprintf(out, size, csv_spec(format), precision, value);
+            if (n >= pow10[digits])
+                ++exp10;
+            else if (n < pow10[digits - 1])
+                --exp10;
+            else
+                break;
+        }
+    }
+    if (format == DataFormat::Default && exp10 < digits && exp10 >= -4) {
+        char* begin = p;
+        p = write_fixed(p, n, digits - 1 - exp10);
+        p = strip_zeros(begin, p);
+    }
+    else {
+        char* begin = p;
+        p = write_fixed(p, n, digits - 1);
+        if (format == DataFormat::Default)
+            p = strip_zeros(begin, p);
+        p = write_exponent(p, exp10);
+    }
+    *p = '\0';
+    return static_cast<int>(p - out);
+}
+
+#else
+
+int format_double(char* out, std::size_t size, DataFormat format, int precision, double value) {
+    return std::snprintf(out, size, csv_spec(format), precision, value);
+}
+
+#endif
+
+/// Appends #size values to #out as a csv row ending in "\r\n"
+void append_csv_row(std::string& out, const double* row, std::size_t size, DataFormat format, int precision) {
+    for (std::size_t i = 0; i < size; ++i) {
+        std::size_t pos = out.size();
+        out.resize(pos + 64);
+        int n = format_double(&out[pos], 64, format, precision, row[i]);
+        if (n >= 64) {
+            out.resize(pos + n + 1);
+            format_double(&out[pos], n + 1, format, precision, row[i]);
+        }
+        out.resize(pos + (n > 0 ? n : 0));
+        out += i + 1 < size ? "," : "\r\n";
+    }
+}
+
+/// Powers of ten that are exact doubles
+const double EXACT_POW10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// Parses the number at the start of [p, end) like strtod and moves #p past
+/// it. When the digits fit in 2^53 and the decimal exponent in EXACT_POW10,
+/// one multiply or divide of two exact values gives the correctly rounded
+/// result (Clinger's fast path), which covers everything DataLogger writes
+/// at the usual precisions. Anything else is handed to strtod.
+bool parse_double(const char*& p, const char* end, double& value) {
+    const char* q = p;
+    while (q < end && (*q == ' ' || *q == '\t'))
+        ++q;
+    const char* start = q;
+    bool negative = false;
+    if (q < end && (*q == '-' || *q == '+'))
+        negative = *q++ == '-';
+    uint64 mantissa = 0;
+    int digits   = 0;
+    int exponent = 0;
+    bool any     = false;
+    bool exact   = true;
+    bool fraction = false;
+    for (; q < end; ++q) {
+        if (*q == '.' && !fraction) {
+            fraction = true;
+            continue;
+        }
+        unsigned d = static_cast<unsigned>(*q - '0');
+        if (d > 9)
+            break;
+        any = true;
+        if (mantissa == 0 && d == 0) {
+            exponent -= fraction;
+            continue;
+        }
+        if (digits == 19) {
+            exact = false;
+            break;
+        }
+        mantissa = mantissa * 10 + d;
+        ++digits;
+        exponent -= fraction;
+    }
+    if (any && exact && q < end && (*q == 'e' || *q == 'E')) {
+        const char* e = q + 1;
+        bool e_negative = false;
+        if (e < end && (*e == '-' || *e == '+'))
+            e_negative = *e++ == '-';
+        int e_value = 0;
+        const char* e_digits = e;
+        for (; e < end && static_cast<unsigned>(*e - '0') <= 9; ++e) {
+            if (e_value < 10000)
+                e_value = e_value * 10 + (*e - '0');
+        }
+        if (e != e_digits) {
+            exponent += e_negative ? -e_value : e_value;
+            q = e;
+        }
+    }
+    if (any && exact && mantissa <= (static_cast<uint64>(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double m = static_cast<double>(mantissa);
+        value = exponent < 0 ? m / EXACT_POW10[-exponent] : m * EXACT_POW10[exponent];
+        if (negative)
+            value = -value;
+        p = q;
+        return true;
+    }
+    // the map is not null terminated, so strtod gets a copy of the token
+    char token[64];
+    std::size_t length = std::min<std::size_t>(end - start, sizeof(token) - 1);
+    std::memcpy(token, start, length);
+    token[length] = '\0';
+    char* token_end;
+    value = std::strtod(token, &token_end);
+    if (token_end == token) {
+        value = 0.0;
+        return false;
+    }
+    p = start + (token_end - token);
+    return true;
+}
+
+/// Returns the end of the text in #data, before the zero bytes left after it
+/// by a MappedFile that was never closed (e.g. after a crash)
+const char* text_end(const char* data, std::size_t size) {
+    const char* end = data + size;
+    while (end > data && end[-1] == '\0')
+        --end;
+    return end;
+}
+
+/// Finds the next line in [pos, end), without its "\n" or "\r\n", and moves
+/// #pos to the line after it. Returns false at the end of the text.
+bool next_csv_line(const char*& pos, const char* end, const char*& line_begin, const char*& line_end) {
+    if (pos >= end)
+        return false;
+    line_begin = pos;
+    const char* newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+    line_end = newline ? newline : end;
+    pos = newline ? newline + 1 : end;
+    if (line_end > line_begin && line_end[-1] == '\r')
+        --line_end;
+    return true;
+}
+
+/// Splits a csv line into its values. Cells that are not numbers read as 0.
+void parse_csv_values(const char* begin, const char* end, std::vector<double>& row) {
+    row.clear();
+    while (begin < end) {
+        const char* comma = static_cast<const char*>(std::memchr(begin, ',', end - begin));
+        const char* cell_end = comma ? comma : end;
+        double value;
+        parse_double(begin, cell_end, value);
+        row.push_back(value);
+        begin = comma ? comma + 1 : end;
+    }
+}
+
+/// Splits a csv line into its cells
+void parse_csv_names(const char* begin, const char* end, std::vector<std::string>& names) {
+    names.clear();
+    while (begin < end) {
+        const char* comma = static_cast<const char*>(std::memchr(begin, ',', end - begin));
+        const char* cell_end = comma ? comma : end;
+        names.push_back(std::string(begin, cell_end));
+        begin = comma ? comma + 1 : end;
+    }
+}
+
+/// Returns true if the line starts with the Table header id
+bool is_table_header(const char* begin, const char* end) {
+    const char* comma = static_cast<const char*>(std::memchr(begin, ',', end - begin));
+    return Table::table_id.compare(0, std::string::npos, begin, (comma ? comma : end) - begin) == 0;
+}
+
+} // namespace
+
+//==============================================================================
+// CHUNKED FILE WRITER
+//==============================================================================
+
+namespace {
+
+/// Bytes formatted before each write to a file
+const std::size_t CHUNK_BYTES = 1 << 20;
+
+/// Formats rows into a fixed, reusable buffer and writes it to a File or
+/// MappedFile in CHUNK_BYTES blocks, so memory stays bounded however many
+/// rows are written. Binary rows are padded or truncated to #bin_cols values.
+template <class FileType>
+class ChunkWriter : NonCopyable {
+public:
+    ChunkWriter(FileType& file,
+                FileFormat file_format = FileFormat::Csv,
+                DataFormat format      = DataFormat::Default,
+                std::size_t precision  = 6,
+                std::size_t bin_cols   = 0) :
+        file_(file),
+        file_format_(file_format),
+        format_(format),
+        precision_(static_cast<int>(precision)),
+        bin_cols_(bin_cols),
+        buffer_(CHUNK_BYTES),
+        used_(0),
+        written_(0)
+    { }
+
+    ~ChunkWriter() {
+        flush();
+    }
+
+    /// Appends raw bytes
+    void write(const char* data, std::size_t size) {
+        if (used_ + size > buffer_.size()) {
+            flush();
+            if (size > buffer_.size()) {
+                write_file(data, size);
+                return;
+            }
+        }
+        std::memcpy(&buffer_[used_], data, size);
+        used_ += size;
+    }
+
+    /// Appends a string
+    void write(const std::string& str) {
+        write(str.data(), str.size());
+    }
+
+    /// Appends a row of values as csv text or binary, per the FileFormat
+    void write_row(const double* row, std::size_t size) {
+        if (file_format_ != FileFormat::Csv) {
+            std::size_t n = std::min(size, bin_cols_);
+            std::size_t value_bytes = file_format_ == FileFormat::Binary64 ? sizeof(double) : sizeof(float);
+            if (file_format_ == FileFormat::Binary64) {
+                write(reinterpret_cast<const char*>(row), n * sizeof(double));
+            }
+            else {
+                for (std::size_t i = 0; i < n; ++i) {
+                    float value = static_cast<float>(row[i]);
+                    write(reinterpret_cast<const char*>(&value), sizeof(value));
+                }
+            }
+            static const char zeros[sizeof(double)] = {0};
+            for (std::size_t i = n; i < bin_cols_; ++i)
+                write(zeros, value_bytes);
+            return;
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            // same text as an ostream with the matching floatfield/precision,
+            // reformatted into an empty buffer if it did not fit
+            int n = format_value(row[i]);
+            if (n < 0)
+                continue;
+            if (used_ + n + 2 > buffer_.size()) {
+                flush();
+                n = format_value(row[i]);
+            }
+            used_ += n;
+            buffer_[used_++] = i + 1 < size ? ',' : '\r';
+        }
+        if (size > 0)
+            buffer_[used_++] = '\n';
+    }
+
+    /// Appends a row of column names as csv text
+    void write_row(const std::vector<std::string>& names) {
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            write(names[i]);
+            write(i + 1 < names.size() ? "," : "\r\n", i + 1 < names.size() ? 1 : 2);
+        }
+    }
+
+    /// Writes out whatever is buffered
+    void flush() {
+        if (used_ > 0) {
+            write_file(&buffer_[0], used_);
+            used_ = 0;
+        }
+    }
+
+    /// Returns the number of bytes written to the file so far
+    std::size_t get_bytes_written() const {
+        return written_;
+    }
+
+private:
+    int format_value(double value) {
+        if (used_ == buffer_.size())
+            flush();
+        return format_double(&buffer_[used_], buffer_.size() - used_, format_, precision_, value);
+    }
+
+    void write_file(const char* data, std::size_t size) {
+        int bytes_written = file_.write(data, size);
+        if (bytes_written > 0)
+            written_ += static_cast<std::size_t>(bytes_written);
+    }
+
+    FileType& file_;
+    FileFormat file_format_;
+    DataFormat format_;
+    int precision_;
+    std::size_t bin_cols_;
+    std::vector<char> buffer_;
+    std::size_t used_;
+    std::size_t written_;
+};
+
+} // namespace
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
 
 bool DataLogger::write_to_csv(const std::vector<std::string> &header, const std::string &filename, const std::string& directory, bool timestamp) {
 	std::string filename_no_ext;
@@ -61,15 +865,11 @@ bool DataLogger::write_to_csv(const std::vector<std::vector<double>> &data, cons
 	File::unlink(full_filename.c_str());
 	File file;
 	file.open(full_filename.c_str());
-
-	for (std::size_t i = 0; i < data.size(); i++) {
-		std::ostringstream ss;
-		ss << std::setprecision(6);
-		for (size_t j = 0; j < data[i].size() - 1; ++j) {
-			ss << data[i][j] << ",";
+	{
+		ChunkWriter<File> writer(file);
+		for (std::size_t i = 0; i < data.size(); i++) {
+			writer.write_row(data[i].data(), data[i].size());
 		}
-		ss << data[i].back() << "\r\n";
-		file.write(ss.str());
 	}
 	file.close();
 	return true;
@@ -96,22 +896,18 @@ bool DataLogger::write_to_csv(const Table &data, const std::string &filename, co
 	File::unlink(full_filename.c_str());
 	File file;
 	file.open(full_filename.c_str());
-	std::ostringstream oss;
-	oss << std::setprecision(6);
-	oss << make_csv_header(data);
-	if (!data.empty()) {
-		for (std::size_t i = 0; i < data.col_count() - 1; i++) {
-			oss << data.get_col_name(i) << ",";
-		}
-		oss << data.get_col_name(data.col_count() - 1) << "\r\n";
-		for (std::size_t i = 0; i < data.row_count(); i++) {
-			for (size_t j = 0; j < data.col_count() - 1; ++j) {
-				oss << data(i, j) << ",";
+	{
+		ChunkWriter<File> writer(file);
+		writer.write(make_csv_header(data));
+		if (!data.empty()) {
+			writer.write_row(data.get_col_names());
+			std::vector<double> row;
+			for (std::size_t i = 0; i < data.row_count(); i++) {
+				data.get_row(i, row);
+				writer.write_row(row.data(), row.size());
 			}
-			oss << data(i, data.col_count() - 1) << "\r\n";
 		}
 	}
-	file.write(oss.str());
 	file.close();
 	return true;
 }
@@ -137,25 +933,21 @@ bool DataLogger::write_to_csv(const std::vector<Table> &data, const std::string
 	File::unlink(full_filename.c_str());
 	File file;
 	file.open(full_filename.c_str());
-	std::ostringstream oss;
-	oss << std::setprecision(6);
-	for (std::size_t k = 0; k < data.size(); ++k) {
-		oss << make_csv_header(data[k]);
-		if (!data[k].empty()) {
-			for (std::size_t i = 0; i < data[k].col_count() - 1; i++) {
-				oss << data[k].get_col_name(i) << ",";
+	{
+		ChunkWriter<File> writer(file);
+		for (std::size_t k = 0; k < data.size(); ++k) {
+			writer.write(make_csv_header(data[k]));
+			if (!data[k].empty()) {
+				writer.write_row(data[k].get_col_names());
 			}
-			oss << data[k].get_col_name(data[k].col_count() - 1) << "\r\n";
-		}
-		for (std::size_t i = 0; i < data[k].row_count(); i++) {
-			for (size_t j = 0; j < data[k].col_count() - 1; ++j) {
-				oss << data[k](i, j) << ",";
+			std::vector<double> row;
+			for (std::size_t i = 0; i < data[k].row_count(); i++) {
+				data[k].get_row(i, row);
+				writer.write_row(row.data(), row.size());
 			}
-			oss << data[k](i, data[k].col_count() - 1) << "\r\n";
+			writer.write("\r\n");
 		}
-		oss << "\r\n";
 	}
-	file.write(oss.str());
 	file.close();
 	return true;
 }
@@ -170,25 +962,19 @@ bool DataLogger::read_from_csv(std::vector<std::vector<double>> &data, const std
 	std::string full_filename;
 	full_filename = directory + get_path_slash() + filename_no_ext + "." + file_ext;
 	LOG(Verbose) << "Reading data from " << full_filename;
-	std::vector<std::vector<double>> output;
-	std::ifstream input(full_filename);
-	input.precision(6);
+	MappedInput input(full_filename);
 	if (!input.is_open()) {
 		LOG(Warning) << "File not found in DataLogger::read_from_csv().";
 		return false;
 	}
 	data.clear();
-	std::string csv_line;
-	while (std::getline(input, csv_line)) {
-		std::istringstream csv_stream(csv_line);
-		std::vector<double> row;
-		std::string value_str;
-		double value;
-		while (std::getline(csv_stream, value_str, ',')) {
-			std::istringstream ss(value_str);
-			ss >> value;
-			row.push_back(value);
-		}
+	const char* pos = input.data();
+	const char* end = text_end(pos, input.size());
+	const char* line_begin;
+	const char* line_end;
+	std::vector<double> row;
+	while (next_csv_line(pos, end, line_begin, line_end)) {
+		parse_csv_values(line_begin, line_end, row);
 		data.push_back(row);
 	}
 	return true;
@@ -204,53 +990,39 @@ bool DataLogger::read_from_csv(Table &data, const std::string &filename, const s
 	std::string full_filename;
 	full_filename = directory + get_path_slash() + filename_no_ext + "." + file_ext;
 	LOG(Verbose) << "Reading data from " << full_filename;
-	std::vector<std::vector<double>> output;
-	std::ifstream input(full_filename);
-	input.precision(6);
+	MappedInput input(full_filename);
 	if (!input.is_open()) {
 		LOG(Warning) << "File not found in DataLogger::read_from_csv().";
 		return false;
 	}
 	bool is_table = false;
 	data.clear();
-	std::string csv_line;
-	std::string el_str;
-	double value;
+	const char* pos = input.data();
+	const char* end = text_end(pos, input.size());
+	const char* line_begin;
+	const char* line_end;
 	std::vector<std::string> name_row;
 	std::vector<double> value_row;
-	while (std::getline(input, csv_line)) {
-		std::istringstream iss(csv_line);
-		if (std::getline(iss, el_str, ',')) {
-			if (el_str.compare(Table::table_id) == 0) {
-				if (!parse_csv_header(data, csv_line)) {
-					LOG(Warning) << "Table header in " << full_filename << " could not be parsed.";
-					return false;
-				}
-				is_table = true;
-				break;
+	while (next_csv_line(pos, end, line_begin, line_end)) {
+		if (is_table_header(line_begin, line_end)) {
+			if (!parse_csv_header(data, std::string(line_begin, line_end))) {
+				LOG(Warning) << "Table header in " << full_filename << " could not be parsed.";
+				return false;
 			}
+			is_table = true;
+			break;
 		}
 	}
 	if (!is_table) {
 		LOG(Warning) << "File does not contain valid MEL::Table header.";
 		return false;
 	}
-	if (std::getline(input, csv_line)) {
-		std::istringstream iss(csv_line);
-		name_row.clear();
-		while (std::getline(iss, el_str, ',')) {
-			name_row.push_back(el_str);
-		}
+	if (next_csv_line(pos, end, line_begin, line_end)) {
+		parse_csv_names(line_begin, line_end, name_row);
 		data.set_col_names(name_row);
 	}
-	while (std::getline(input, csv_line)) {
-		std::istringstream iss(csv_line);
-		value_row.clear();
-		while (std::getline(iss, el_str, ',')) {
-			std::istringstream el_iss(el_str);
-			el_iss >> value;
-			value_row.push_back(value);
-		}
+	while (next_csv_line(pos, end, line_begin, line_end)) {
+		parse_csv_values(line_begin, line_end, value_row);
 		data.push_back_row(value_row);
 	}
 	return true;
@@ -266,9 +1038,7 @@ bool DataLogger::read_from_csv(std::vector<Table> &data, const std::string &file
 	std::string full_filename;
 	full_filename = directory + get_path_slash() + filename_no_ext + "." + file_ext;
 	LOG(Verbose) << "Reading data from " << full_filename;
-	std::vector<std::vector<double>> output;
-	std::ifstream input(full_filename);
-	input.precision(6);
+	MappedInput input(full_filename);
 	if (!input.is_open()) {
 		LOG(Warning) << "File not found in DataLogger::read_from_csv().";
 		return false;
@@ -278,58 +1048,37 @@ bool DataLogger::read_from_csv(std::vector<Table> &data, const std::string &file
 	bool scan_for_table = true;
 	bool new_table = false;
 	std::size_t table_index = 0;
-	std::string csv_line;
-	std::string el_str;
-	double value;
+	const char* pos = input.data();
+	const char* end = text_end(pos, input.size());
+	const char* line_begin;
+	const char* line_end;
 	std::vector<std::string> header_row;
 	std::vector<double> value_row;
-	while (std::getline(input, csv_line)) {
-		std::istringstream iss(csv_line);
+	while (next_csv_line(pos, end, line_begin, line_end)) {
 		if (scan_for_table) {
-			if (std::getline(iss, el_str, ',')) {
-				if (el_str.compare(Table::table_id) == 0) {
-					data.emplace_back();
-					if (!parse_csv_header(data[table_index], csv_line)) {
-						LOG(Warning) << "Table header in " << full_filename << " could not be parsed.";
-						return false;
-					}
-					is_table = true;
-					scan_for_table = false;
-					new_table = true;
-
+			if (is_table_header(line_begin, line_end)) {
+				data.emplace_back();
+				if (!parse_csv_header(data[table_index], std::string(line_begin, line_end))) {
+					LOG(Warning) << "Table header in " << full_filename << " could not be parsed.";
+					return false;
 				}
+				is_table = true;
+				scan_for_table = false;
+				new_table = true;
 			}
 		}
+		else if (new_table) {
+			parse_csv_names(line_begin, line_end, header_row);
+			data[table_index].set_col_names(header_row);
+			new_table = false;
+		}
+		else if (line_begin != line_end) {
+			parse_csv_values(line_begin, line_end, value_row);
+			data[table_index].push_back_row(value_row);
+		}
 		else {
-			if (new_table) {
-				//std::istringstream csv_stream(csv_line);
-				//std::vector<std::string> header_row;
-				//std::string value_str;
-				header_row.clear();
-				while (std::getline(iss, el_str, ',')) {
-					header_row.push_back(el_str);
-				}
-				data[table_index].set_col_names(header_row);
-				new_table = false;
-			}
-			//std::istringstream csv_stream(csv_line);
-			//std::vector<double> row;
-			//std::string value_str;
-			else {
-				if (!csv_line.empty()) {
-					value_row.clear();
-					while (std::getline(iss, el_str, ',')) {
-						std::istringstream el_iss(el_str);
-						el_iss >> value;
-						value_row.push_back(value);
-					}
-					data[table_index].push_back_row(value_row);
-				}
-				else {
-					scan_for_table = true;
-					table_index++;
-				}
-			}
+			scan_for_table = true;
+			table_index++;
 		}
 	}
 	if (!is_table) {
@@ -374,6 +1123,112 @@ bool DataLogger::read_from_csv(std::vector<Table> &data, const std::string &file
 	return true;
 }
 
+bool DataLogger::write_to_bin(const Table &data, const std::string &filename, const std::string& directory, bool timestamp, FileFormat format) {
+	std::string new_filename = filename.empty() ? (data.name().empty() ? "mel_table" : data.name()) : filename;
+	std::string filename_no_ext;
+	std::string file_ext;
+	split_file_name(new_filename.c_str(), filename_no_ext, file_ext);
+	if (file_ext.empty()) {
+		file_ext = "mlog";
+	}
+	if (format == FileFormat::Csv) {
+		format = FileFormat::Binary64;
+	}
+	std::string full_filename;
+	if (timestamp) {
+		Timestamp stamp;
+		full_filename = directory + get_path_slash() + filename_no_ext + "_" + stamp.yyyy_mm_dd_hh_mm_ss() + "." + file_ext;
+	}
+	else {
+		full_filename = directory + get_path_slash() + filename_no_ext + "." + file_ext;
+	}
+	LOG(Verbose) << "Saving data to " << full_filename;
+	create_directory(directory);
+	File::unlink(full_filename.c_str());
+	File file;
+	file.open(full_filename.c_str());
+	{
+		ChunkWriter<File> writer(file, format, DataFormat::Default, 6, data.col_count());
+		writer.write(make_bin_header(data.name(), data.get_col_names(), data.col_count(), format, data.row_count()));
+		std::vector<double> row;
+		for (std::size_t i = 0; i < data.row_count(); i++) {
+			data.get_row(i, row);
+			writer.write_row(row.data(), row.size());
+		}
+	}
+	file.close();
+	return true;
+}
+
+bool DataLogger::read_from_bin(Table &data, const std::string &filename, const std::string& directory) {
+	std::string filename_no_ext;
+	std::string file_ext;
+	split_file_name(filename.c_str(), filename_no_ext, file_ext);
+	if (file_ext.empty()) {
+		file_ext = "mlog";
+	}
+	std::string full_filename = directory + get_path_slash() + filename_no_ext + "." + file_ext;
+	LOG(Verbose) << "Reading data from " << full_filename;
+	MappedInput file(full_filename);
+	BinHeader header;
+	if (!read_bin_header(file, header, "read_from_bin"))
+		return false;
+	std::size_t col_count = header.col_names.size();
+	std::size_t row_count = header.row_count();
+	data.clear();
+	data.rename(header.name);
+	data.set_col_names(header.col_names);
+	data.reserve(row_count);
+	std::vector<double> values(col_count);
+	const char* row = file.data() + header.data_offset;
+	for (std::size_t i = 0; i < row_count; ++i, row += header.row_bytes) {
+		decode_bin_row(row, header, values.data());
+		data.push_back_row(values);
+	}
+	return true;
+}
+
+bool DataLogger::bin_to_csv(const std::string &bin_filename, const std::string &csv_filename, const std::string& directory) {
+	std::string filename_no_ext;
+	std::string file_ext;
+	split_file_name(bin_filename.c_str(), filename_no_ext, file_ext);
+	if (file_ext.empty()) {
+		file_ext = "mlog";
+	}
+	std::string full_bin_filename = directory + get_path_slash() + filename_no_ext + "." + file_ext;
+	std::string csv_no_ext = filename_no_ext;
+	std::string csv_ext = "csv";
+	if (!csv_filename.empty()) {
+		split_file_name(csv_filename.c_str(), csv_no_ext, csv_ext);
+		if (csv_ext.empty()) {
+			csv_ext = "csv";
+		}
+	}
+	std::string full_csv_filename = directory + get_path_slash() + csv_no_ext + "." + csv_ext;
+	LOG(Verbose) << "Converting " << full_bin_filename << " to " << full_csv_filename;
+	MappedInput bin(full_bin_filename);
+	BinHeader header;
+	if (!read_bin_header(bin, header, "bin_to_csv"))
+		return false;
+	File::unlink(full_csv_filename.c_str());
+	File file;
+	file.open(full_csv_filename.c_str());
+	std::size_t col_count = header.col_names.size();
+	std::size_t row_count = header.row_count();
+	{
+		ChunkWriter<File> writer(file);
+		writer.write_row(header.col_names);
+		std::vector<double> row(col_count);
+		const char* data = bin.data() + header.data_offset;
+		for (std::size_t i = 0; i < row_count && col_count > 0; ++i, data += header.row_bytes) {
+			decode_bin_row(data, header, row.data());
+			writer.write_row(row.data(), col_count);
+		}
+	}
+	file.close();
+	return true;
+}
+
 std::string DataLogger::make_csv_header(const Table &table) {
 	std::ostringstream oss;
 	oss << Table::table_id << ",";
@@ -401,7 +1256,8 @@ bool DataLogger::parse_csv_header(Table &table, const std::string &header) {
 				}
 				else if (param_name_str.compare("n_rows") == 0) {
 					std::size_t n_rows;
-					el_iss >> n_rows;
+					if (el_iss >> n_rows)
+						table.reserve(n_rows);
 
 				}
 				else if (param_name_str.compare("n_cols") == 0) {
@@ -431,22 +1287,37 @@ DataLogger::DataLogger(WriterType writer_type, bool autosave, size_t max_rows) :
     row_count_(0),
     col_count_(0),
     max_rows_(max_rows),
+    bin_col_count_(0),
     format_(DataFormat::Default),
-    precision_(6) {
+    precision_(6),
+    file_format_(FileFormat::Csv),
+    chunk_rows_(1024),
+    chunk_count_(16),
+    chunk_(0),
+    chunk_row_(0),
+    dropped_rows_(0),
+    published_(0),
+    consumed_(0),
+    streaming_(false) {
     if (writer_type == WriterType::Buffered) {
         data_buffer_.reserve(max_rows);
     }
 }
 
 DataLogger::~DataLogger() {
+    if (streaming_)
+        close();
     if (autosave_ && row_count_ > 0 && !log_saved_ && !saving_) {
-        save_data("log", "autosaved_logs", true);
+        save_and_clear_data("log", "autosaved_logs", true);
     }
     wait_for_save();
 }
 
 void DataLogger::buffer(const std::vector<double>& data_record) {
-    if (writer_type_ == WriterType::Buffered) {
+    if (writer_type_ == WriterType::Streaming) {
+        buffer(data_record.data(), data_record.size());
+    }
+    else if (writer_type_ == WriterType::Buffered) {
         Lock lock(mutex_);
         if (row_count_ == max_rows_)
             double_rows();
@@ -459,23 +1330,30 @@ void DataLogger::buffer(const std::vector<double>& data_record) {
     }
 }
 
+void DataLogger::buffer(const double* data_record, std::size_t size) {
+    if (writer_type_ != WriterType::Streaming) {
+        buffer(std::vector<double>(data_record, data_record + size));
+        return;
+    }
+    if (!streaming_)
+        return;
+    // a new chunk may only be started once the writer has freed its slot
+    if (chunk_row_ == 0 && chunk_ - consumed_.load(std::memory_order_acquire) >= chunk_count_) {
+        dropped_rows_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    double* row = &arena_[((chunk_ % chunk_count_) * chunk_rows_ + chunk_row_) * col_count_];
+    std::size_t n = std::min(size, col_count_);
+    std::copy(data_record, data_record + n, row);
+    std::fill(row + n, row + col_count_, 0.0);
+    row_count_ += 1;
+    if (++chunk_row_ == chunk_rows_)
+        publish_chunk();
+}
+
 void DataLogger::save_data(const std::string& filename, const std::string& directory, bool timestamp) {
     if (writer_type_ == WriterType::Buffered) {
-        saving_ = true;
-        split_file_name(filename.c_str(), filename_no_ext_, file_ext_);
-        if (file_ext_.empty()) {
-            file_ext_ = "csv";
-        }
-        std::string full_filename;
-        if (timestamp) {
-            Timestamp stamp;
-            full_filename = directory + get_path_slash() + filename_no_ext_ + "_" + stamp.yyyy_mm_dd_hh_mm_ss() + "." + file_ext_;
-        }
-        else
-            full_filename = directory + get_path_slash() + filename_no_ext_ + "." + file_ext_;
-        LOG(Verbose) << "Saving data to " << full_filename;
-        std::thread t(&DataLogger::save_thread_func, this, full_filename, directory, data_buffer_);
-        t.detach();
+        save(filename, directory, timestamp, data_buffer_);
     }
     else {
         LOG(Warning) << "Nothing written to DataLogger. Can only use save_data() on DataLogger with WriterType::Buffered.";
@@ -496,7 +1374,10 @@ void DataLogger::clear_data() {
 
 void DataLogger::save_and_clear_data(std::string filename, std::string directory, bool timestamp) {
     if (writer_type_ == WriterType::Buffered) {
-        save_data(filename, directory, timestamp);
+        // hand the rows to the saving thread rather than copying them
+        std::vector<std::vector<double>> data;
+        data.swap(data_buffer_);
+        save(filename, directory, timestamp, std::move(data));
         clear_data();
     }
     else {
@@ -521,11 +1402,16 @@ void DataLogger::write(const std::vector<double>& data_record) {
         }
 
         if (file_size_ == 0) {
-            write_header();
+            write_header(data_record.size());
         }
 
-        int bytes_written =
-            file_.write(format(data_record));
+        // formatted into a reused buffer, so a row costs no allocation
+        row_text_.clear();
+        if (file_format_ != FileFormat::Csv)
+            append_bin_row(row_text_, data_record.data(), data_record.size(), bin_col_count_, file_format_);
+        else
+            append_csv_row(row_text_, data_record.data(), data_record.size(), format_, static_cast<int>(precision_));
+        int bytes_written = file_.write(row_text_);
         if (bytes_written > 0) {
             file_size_ += bytes_written;
             row_count_ += 1;
@@ -538,10 +1424,10 @@ void DataLogger::write(const std::vector<double>& data_record) {
 
 
 void DataLogger::open(const std::string& filename, const std::string& directory, bool timestamp) {
-    if (writer_type_ == WriterType::Immediate) {
+    if (writer_type_ == WriterType::Immediate || writer_type_ == WriterType::Streaming) {
         split_file_name(filename.c_str(), filename_no_ext_, file_ext_);
         if (file_ext_.empty()) {
-            file_ext_ = "csv";
+            file_ext_ = file_format_ == FileFormat::Csv ? "csv" : "mlog";
         }
         std::string full_filename;
         if (timestamp) {
@@ -554,17 +1440,19 @@ void DataLogger::open(const std::string& filename, const std::string& directory,
         File::unlink(full_filename.c_str());
         file_size_ = file_.open(full_filename.c_str());
         file_opened_ = true;
+        if (writer_type_ == WriterType::Streaming)
+            start_stream();
     }
     else {
-        LOG(Warning) << "DataLogger file not opened. Can only use open() on DataLogger with WriterType::Immediate.";
+        LOG(Warning) << "DataLogger file not opened. Can only use open() on DataLogger with WriterType::Immediate or WriterType::Streaming.";
     }
 }
 
 void DataLogger::reopen(const std::string& filename, const std::string& directory, bool timestamp) {
-    if (writer_type_ == WriterType::Immediate) {
+    if (writer_type_ == WriterType::Immediate || writer_type_ == WriterType::Streaming) {
         split_file_name(filename.c_str(), filename_no_ext_, file_ext_);
         if (file_ext_.empty()) {
-            file_ext_ = "csv";
+            file_ext_ = file_format_ == FileFormat::Csv ? "csv" : "mlog";
         }
         std::string full_filename;
         if (timestamp) {
@@ -574,16 +1462,48 @@ void DataLogger::reopen(const std::string& filename, const std::string& director
         else
             full_filename = directory + get_path_slash() + filename_no_ext_ + "." + file_ext_;
         LOG(Verbose) << "Reopening data file " << full_filename;
-        file_size_ = file_.open(full_filename.c_str());
+        // append after the committed data, dropping the zero tail and any
+        // partial row a crash left behind
+        off_t length = -1;
+        bool length_field = false;
+        {
+            MappedInput existing(full_filename);
+            BinHeader header;
+            if (file_format_ == FileFormat::Csv) {
+                if (existing.size() > 0)
+                    length = static_cast<off_t>(text_end(existing.data(), existing.size()) - existing.data());
+            }
+            else if (existing.size() > 0 && parse_bin_header(existing.data(), existing.size(), header)) {
+                // appended rows must match the column count already in the file
+                bin_col_count_ = header.col_types.size();
+                length = static_cast<off_t>(header.data_offset + header.row_count() * header.row_bytes);
+                length_field = header.version >= 2;
+            }
+        }
+        file_size_ = file_.open(full_filename.c_str(), length);
+        if (length_field)
+            file_.set_length_field(BIN_LENGTH_OFFSET);
         file_opened_ = true;
+        if (writer_type_ == WriterType::Streaming)
+            start_stream();
     }
     else {
-        LOG(Warning) << "DataLogger file not opened. Can only use reopen() on DataLogger with WriterType::Immediate.";
+        LOG(Warning) << "DataLogger file not opened. Can only use reopen() on DataLogger with WriterType::Immediate or WriterType::Streaming.";
     }
 }
 
 void DataLogger::close() {
-    if (writer_type_ == WriterType::Immediate) {
+    if (writer_type_ == WriterType::Streaming) {
+        if (streaming_) {
+            if (chunk_row_ > 0)
+                publish_chunk();
+            streaming_ = false;
+            stream_thread_.join();
+        }
+        file_.close();
+        file_opened_ = false;
+    }
+    else if (writer_type_ == WriterType::Immediate) {
         file_.close();
         file_opened_ = false;
     }
@@ -593,6 +1513,8 @@ void DataLogger::close() {
 }
 
 void DataLogger::set_writer_type(WriterType writer_type) {
+    if (streaming_ && writer_type != WriterType::Streaming)
+        close();
     switch (writer_type) {
     case WriterType::Buffered:
         if (writer_type_ != WriterType::Buffered) {
@@ -612,6 +1534,15 @@ void DataLogger::set_writer_type(WriterType writer_type) {
             writer_type_ = WriterType::Immediate;
         }
         break;
+    case WriterType::Streaming:
+        if (writer_type_ != WriterType::Streaming) {
+            if (file_opened_) {
+                file_.close();
+                file_opened_ = false;
+            }
+            writer_type_ = WriterType::Streaming;
+        }
+        break;
     }
 }
 
@@ -625,6 +1556,23 @@ void DataLogger::set_record_format(DataFormat data_format, std::size_t precision
     precision_ = precision;
 }
 
+void DataLogger::set_file_format(FileFormat file_format) {
+    file_format_ = file_format;
+}
+
+void DataLogger::set_stream_capacity(std::size_t chunk_rows, std::size_t chunk_count) {
+    if (streaming_) {
+        LOG(Warning) << "DataLogger stream capacity not changed. Must use set_stream_capacity() before open().";
+        return;
+    }
+    chunk_rows_  = std::max<std::size_t>(chunk_rows, 1);
+    chunk_count_ = std::max<std::size_t>(chunk_count, 2);
+}
+
+std::size_t DataLogger::get_dropped_rows() const {
+    return dropped_rows_.load(std::memory_order_relaxed);
+}
+
 std::size_t DataLogger::get_row_count() const {
     return row_count_;
 }
@@ -648,21 +1596,25 @@ std::vector<double> DataLogger::get_col(std::size_t col) {
 
 
 std::string DataLogger::format(const std::vector<double>& data_record) {
-    std::ostringstream ss;
-    ss << std::setprecision(precision_);
-    if (format_ == DataFormat::Fixed)
-        ss << std::fixed;
-    else if (format_ == DataFormat::Scientific)
-        ss << std::scientific;
-    for (size_t i = 0; i < data_record.size() - 1; ++i) {
-        ss << data_record[i] << ",";
-    }
-    ss << data_record[data_record.size() - 1] << "\r\n";
-    return ss.str();
+    return format(data_record.data(), data_record.size());
 }
 
-void DataLogger::write_header() {
-    if (!header_.empty()) {
+std::string DataLogger::format(const double* data_record, std::size_t size) {
+    std::string out;
+    if (file_format_ != FileFormat::Csv)
+        append_bin_row(out, data_record, size, size, file_format_);
+    else
+        append_csv_row(out, data_record, size, format_, static_cast<int>(precision_));
+    return out;
+}
+
+void DataLogger::write_header(std::size_t col_count) {
+    if (file_format_ != FileFormat::Csv) {
+        bin_col_count_ = std::max(col_count, header_.size());
+        file_.write(make_bin_header(filename_no_ext_, header_, bin_col_count_, file_format_));
+        file_.set_length_field(BIN_LENGTH_OFFSET);
+    }
+    else if (!header_.empty()) {
         std::ostringstream ss;
         for (size_t i = 0; i < header_.size() - 1; ++i) {
             ss << header_[i] << ",";
@@ -679,15 +1631,38 @@ void DataLogger::double_rows() {
     data_buffer_.reserve(max_rows_);
 }
 
+void DataLogger::save(const std::string& filename, const std::string& directory, bool timestamp, std::vector<std::vector<double>> data) {
+    saving_ = true;
+    split_file_name(filename.c_str(), filename_no_ext_, file_ext_);
+    if (file_ext_.empty()) {
+        file_ext_ = file_format_ == FileFormat::Csv ? "csv" : "mlog";
+    }
+    std::string full_filename;
+    if (timestamp) {
+        Timestamp stamp;
+        full_filename = directory + get_path_slash() + filename_no_ext_ + "_" + stamp.yyyy_mm_dd_hh_mm_ss() + "." + file_ext_;
+    }
+    else
+        full_filename = directory + get_path_slash() + filename_no_ext_ + "." + file_ext_;
+    LOG(Verbose) << "Saving data to " << full_filename;
+    std::thread t(&DataLogger::save_thread_func, this, full_filename, directory, std::move(data));
+    t.detach();
+}
+
 void DataLogger::save_thread_func(const std::string& full_filename, const std::string& directory, std::vector<std::vector<double>> temp_data) {
     Lock lock(mutex_);
     create_directory(directory);
     File::unlink(full_filename.c_str());
     file_.open(full_filename.c_str());
     file_opened_ = true;
-    write_header();
-    for (std::size_t i = 0; i < temp_data.size(); i++) {
-        file_.write(format(temp_data[i]));
+    write_header(temp_data.empty() ? header_.size() : temp_data[0].size());
+    {
+        ChunkWriter<MappedFile> writer(file_, file_format_, format_, precision_, bin_col_count_);
+        for (std::size_t i = 0; i < temp_data.size(); i++) {
+            writer.write_row(temp_data[i].data(), temp_data[i].size());
+            // release rows as they are written so memory falls while saving
+            std::vector<double>().swap(temp_data[i]);
+        }
     }
     file_.close();
     file_opened_ = false;
@@ -695,4 +1670,60 @@ void DataLogger::save_thread_func(const std::string& full_filename, const std::s
     saving_ = false;
 }
 
+void DataLogger::start_stream() {
+    if (streaming_)
+        return;
+    if (col_count_ == 0) {
+        LOG(Error) << "DataLogger stream not started. Must use set_header() before open() on DataLogger with WriterType::Streaming.";
+        return;
+    }
+    // allocate and touch the whole arena now so buffer() never page faults
+    arena_.assign(chunk_count_ * chunk_rows_ * col_count_, 0.0);
+    chunk_fill_.assign(chunk_count_, 0);
+    chunk_     = 0;
+    chunk_row_ = 0;
+    published_ = 0;
+    consumed_  = 0;
+    streaming_ = true;
+    stream_thread_ = std::thread(&DataLogger::stream_thread_func, this);
+}
+
+void DataLogger::publish_chunk() {
+    chunk_fill_[chunk_ % chunk_count_] = chunk_row_;
+    published_.store(++chunk_, std::memory_order_release);
+    chunk_row_ = 0;
+}
+
+void DataLogger::stream_thread_func() {
+    if (file_size_ == 0)
+        write_header(col_count_);
+    ChunkWriter<MappedFile> writer(file_, file_format_, format_, precision_, bin_col_count_);
+    for (;;) {
+        // read before published_: close() publishes its last chunk before
+        // clearing streaming_, so once stopping is seen that chunk is too
+        bool stopping = !streaming_.load(std::memory_order_acquire);
+        std::size_t consumed = consumed_.load(std::memory_order_relaxed);
+        if (consumed == published_.load(std::memory_order_acquire)) {
+            if (stopping)
+                break;
+            sleep(milliseconds(1));
+            continue;
+        }
+        std::size_t slot = consumed % chunk_count_;
+        const double* rows = &arena_[slot * chunk_rows_ * col_count_];
+        std::size_t bytes_written = writer.get_bytes_written();
+        if (file_format_ == FileFormat::Binary64) {
+            // the arena already is the on-disk row layout
+            writer.write(reinterpret_cast<const char*>(rows), chunk_fill_[slot] * col_count_ * sizeof(double));
+        }
+        else {
+            for (std::size_t i = 0; i < chunk_fill_[slot]; ++i)
+                writer.write_row(rows + i * col_count_, col_count_);
+        }
+        writer.flush();
+        file_size_ += writer.get_bytes_written() - bytes_written;
+        consumed_.store(consumed + 1, std::memory_order_release);
+    }
+}
+
 } // namespace mel
@@ -0,0 +1,180 @@
+#include <MEL/Logging/DeferredLog.hpp>
+#include <MEL/Utility/System.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace mel {
+
+//==============================================================================
+// HELPER FUNCTIONS
+//==============================================================================
+
+namespace {
+
+/// Returns the calling thread's ID, asking the OS only once per thread
+uint32 cached_thread_id() {
+    static thread_local uint32 tid = get_thread_id();
+    return tid;
+}
+
+/// Returns the microseconds since the Unix epoch
+int64 now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/// Decodes the argument at #pos, appends its text to #out and moves #pos
+/// past it. Returns false at the end of the arguments.
+bool render_arg(const char*& pos, const char* end, std::string& out) {
+    if (pos >= end)
+        return false;
+    char type = *pos++;
+    char text[32];
+    switch (type) {
+        case detail::DeferredInt: {
+            int64 v;
+            std::memcpy(&v, pos, sizeof(v));
+            pos += sizeof(v);
+            std::snprintf(text, sizeof(text), "%lld", static_cast<long long>(v));
+            out += text;
+            return true;
+        }
+        case detail::DeferredUInt: {
+            uint64 v;
+            std::memcpy(&v, pos, sizeof(v));
+            pos += sizeof(v);
+            std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(v));
+            out += text;
+            return true;
+        }
+        case detail::DeferredDouble: {
+            double v;
+            std::memcpy(&v, pos, sizeof(v));
+            pos += sizeof(v);
+            // same text as streaming the value into a Record
+            std::snprintf(text, sizeof(text), "%g", v);
+            out += text;
+            return true;
+        }
+        case detail::DeferredBool:
+            out += *pos++ ? '1' : '0';
+            return true;
+        case detail::DeferredChar:
+            out += *pos++;
+            return true;
+        case detail::DeferredString: {
+            uint16 n;
+            std::memcpy(&n, pos, sizeof(n));
+            pos += sizeof(n);
+            out.append(pos, n);
+            pos += n;
+            return true;
+        }
+        default:
+            pos = end;
+            return false;
+    }
+}
+
+} // namespace
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
+DeferredLog::DeferredLog(Writer* writer, std::size_t capacity, Severity max_severity) :
+    writer_(writer),
+    ring_(capacity),
+    max_severity_(max_severity),
+    now_us_(now_us()),
+    running_(true)
+{
+    thread_ = std::thread(&DeferredLog::thread_func, this);
+}
+
+DeferredLog::~DeferredLog() {
+    running_ = false;
+    thread_.join();
+}
+
+bool DeferredLog::check_severity(Severity severity) const {
+    return severity <= max_severity_.load(std::memory_order_relaxed);
+}
+
+void DeferredLog::set_max_severity(Severity severity) {
+    max_severity_.store(severity, std::memory_order_relaxed);
+}
+
+void DeferredLog::flush() {
+    ring_.wait_drained();
+}
+
+uint64 DeferredLog::get_dropped_count() const {
+    return ring_.get_dropped_count();
+}
+
+std::string DeferredLog::render(const LogSite& site, const char* args, std::size_t size) {
+    std::string out;
+    const char* pos = args;
+    const char* end = args + size;
+    const char* format = site.format ? site.format : "";
+    for (const char* c = format; *c; ++c) {
+        if (c[0] == '{' && c[1] == '}') {
+            if (!render_arg(pos, end, out))
+                out += "{}";
+            ++c;
+        }
+        else {
+            out += *c;
+        }
+    }
+    // arguments without a {} are appended
+    while (pos < end) {
+        out += ' ';
+        render_arg(pos, end, out);
+    }
+    return out;
+}
+
+DeferredLog::Slot* DeferredLog::claim(const LogSite& site, std::size_t& pos) {
+    Slot* slot = ring_.claim(pos);
+    if (!slot)
+        return NULL;
+    slot->site = &site;
+    slot->time = now_us_.load(std::memory_order_relaxed);
+    slot->tid  = cached_thread_id();
+    return slot;
+}
+
+void DeferredLog::publish(Slot* slot, std::size_t pos, std::size_t size) {
+    slot->size = static_cast<uint32>(size);
+    ring_.publish(pos);
+}
+
+void DeferredLog::thread_func() {
+    for (;;) {
+        // read before draining, see MpscRing
+        bool stop = !running_.load(std::memory_order_acquire);
+        now_us_.store(now_us(), std::memory_order_relaxed);
+        if (drain() == 0) {
+            if (stop)
+                break;
+            sleep(milliseconds(1));
+        }
+    }
+}
+
+std::size_t DeferredLog::drain() {
+    return ring_.drain([this](const Slot& slot) {
+        // keep the cached time fresh while a long backlog is rendered
+        now_us_.store(now_us(), std::memory_order_relaxed);
+        const LogSite& site = *slot.site;
+        Record record(site.severity, site.func, site.line, site.file, Timestamp(slot.time), slot.tid);
+        record << render(site, slot.args, slot.size);
+        if (writer_->check_severity(record.get_severity()))
+            writer_->write(record);
+    });
+}
+
+} // namespace mel
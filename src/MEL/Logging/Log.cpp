@@ -2,7 +2,12 @@
 
 namespace mel {
 
-#ifndef MEL_DISABLE_LOG
+#if !defined(MEL_DISABLE_LOG) && defined(MEL_ASYNC_LOG)
+    static ColorConsoleWriter<TxtFormatter> default_console_writer(Info);
+    static RollingFileWriter<TxtFormatter> default_file_writer("MEL.log", 0, 0, Verbose);
+    static AsyncWriter default_async_writer(&default_file_writer, 4096, Verbose);
+    Logger<DEFAULT_LOGGER>* MEL_LOGGER = &init_logger<DEFAULT_LOGGER>(Verbose, &default_async_writer).add_writer(&default_console_writer);
+#elif !defined(MEL_DISABLE_LOG)
     static ColorConsoleWriter<TxtFormatter> default_console_writer(Info);
     Logger<DEFAULT_LOGGER>* MEL_LOGGER = &init_logger<DEFAULT_LOGGER>(Verbose, "MEL.log", 0, 0).add_writer(&default_console_writer);
 #else
@@ -0,0 +1,287 @@
+#include <MEL/Logging/MappedFile.hpp>
+#include <MEL/Logging/Log.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace mel {
+
+//==============================================================================
+// HELPER FUNCTIONS
+//==============================================================================
+
+#ifndef _WIN32
+
+namespace {
+
+/// Returns the size of a memory page, the granularity of mmap and msync
+std::size_t page_size() {
+    static const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return page;
+}
+
+/// Rounds #size up to a whole number of pages
+std::size_t round_to_pages(std::size_t size) {
+    return (size + page_size() - 1) / page_size() * page_size();
+}
+
+/// Allocates the bytes of #fd from #from up to #to, extending the file
+bool extend_file(int fd, std::size_t from, std::size_t to) {
+#ifdef __linux__
+    // reserves the blocks up front, so storing to the map can't fail later
+    if (fallocate(fd, 0, static_cast<off_t>(from), static_cast<off_t>(to - from)) == 0)
+        return true;
+    // a sparse file would raise SIGBUS on the first store once the disk is
+    // full, so only fall back when the file system can't preallocate at all
+    if (errno != EOPNOTSUPP && errno != ENOSYS)
+        return false;
+#else
+    (void)from;
+#endif
+    return ftruncate(fd, static_cast<off_t>(to)) == 0;
+}
+
+} // namespace
+
+#endif
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
+MappedFile::MappedFile(Time sync_period) :
+    sync_period_(sync_period),
+    fd_(-1),
+    data_(NULL),
+    capacity_(0),
+    size_(0),
+    synced_(0),
+    length_field_(NO_LENGTH_FIELD),
+    out_of_space_(false),
+    running_(false)
+{ }
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+off_t MappedFile::open(const char* fileName, off_t length) {
+    close();
+#ifdef _WIN32
+    // nothing is preallocated, so the file never holds more than was written
+    (void)length;
+    off_t size = file_.open(fileName);
+    size_ = size > 0 ? static_cast<std::size_t>(size) : 0;
+    return size;
+#else
+    fd_ = ::open(fileName, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (fd_ == -1)
+        return -1;
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return -1;
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    if (length >= 0 && static_cast<std::size_t>(length) < size && ftruncate(fd_, length) == 0)
+        size = static_cast<std::size_t>(length);
+    size_.store(size, std::memory_order_relaxed);
+    synced_ = size;
+    if (grow(size + GROW_BYTES)) {
+        running_ = true;
+        thread_  = std::thread(&MappedFile::sync_thread_func, this);
+    }
+    else {
+        // e.g. a file system without mmap support
+        ::lseek(fd_, 0, SEEK_END);
+    }
+    return static_cast<off_t>(size);
+#endif
+}
+
+int MappedFile::write(const void* buf, size_t count) {
+#ifdef _WIN32
+    int result = file_.write(buf, count);
+    if (result > 0) {
+        size_.store(size_.load(std::memory_order_relaxed) + result, std::memory_order_relaxed);
+        store_length(size_.load(std::memory_order_relaxed));
+    }
+    return result;
+#else
+    if (!data_) {
+        if (fd_ == -1)
+            return -1;
+        int result = static_cast<int>(::write(fd_, buf, count));
+        if (result > 0) {
+            size_.store(size_.load(std::memory_order_relaxed) + result, std::memory_order_relaxed);
+            store_length(size_.load(std::memory_order_relaxed));
+        }
+        return result;
+    }
+    std::size_t size = size_.load(std::memory_order_relaxed);
+    if (size + count > capacity_ && !grow(size + count))
+        return -1;
+    std::memcpy(data_ + size, buf, count);
+    size_.store(size + count, std::memory_order_release);
+    return static_cast<int>(count);
+#endif
+}
+
+void MappedFile::sync() {
+#ifndef _WIN32
+    Lock sync_lock(sync_mutex_);
+    std::vector<Mapping> retired;
+    char* data;
+    std::size_t size;
+    {
+        Lock lock(mutex_);
+        retired.swap(retired_);
+        data = data_;
+        size = size_.load(std::memory_order_acquire);
+    }
+    // only sync() unmaps replaced regions, so the writer never waits for it
+    for (std::size_t i = 0; i < retired.size(); ++i)
+        munmap(retired[i].data, retired[i].capacity);
+    if (data && size > synced_) {
+        std::size_t start = synced_ / page_size() * page_size();
+        msync(data + start, size - start, MS_SYNC);
+        synced_ = size;
+        // commit the length only once the bytes it covers are on disk
+        std::size_t field = length_field_;
+        if (field != NO_LENGTH_FIELD && field + sizeof(uint64) <= size) {
+            uint64 length = size;
+            std::memcpy(data + field, &length, sizeof(length));
+            std::size_t page = field / page_size() * page_size();
+            msync(data + page, field + sizeof(length) - page, MS_SYNC);
+        }
+    }
+#endif
+}
+
+void MappedFile::set_length_field(std::size_t offset) {
+    length_field_ = offset;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    store_length(size_);
+    file_.close();
+    size_         = 0;
+    length_field_ = NO_LENGTH_FIELD;
+#else
+    release();
+#endif
+}
+
+void MappedFile::store_length(std::size_t size) {
+    std::size_t field = length_field_;
+    if (field == NO_LENGTH_FIELD || field + sizeof(uint64) > size)
+        return;
+    uint64 length = size;
+#ifdef _WIN32
+    file_.seek(static_cast<off_t>(field), SEEK_SET);
+    file_.write(&length, sizeof(length));
+    file_.seek(0, SEEK_END);
+#else
+    ssize_t result = pwrite(fd_, &length, sizeof(length), static_cast<off_t>(field));
+    (void)result;
+#endif
+}
+
+bool MappedFile::grow(std::size_t size) {
+#ifdef _WIN32
+    (void)size;
+    return false;
+#else
+    std::size_t step     = std::min(std::max(capacity_, GROW_BYTES), MAX_GROW_BYTES);
+    std::size_t capacity = round_to_pages(std::max(size, capacity_ + step));
+    if (!extend_file(fd_, capacity_, capacity)) {
+        // when a full step doesn't fit, reserve only what this write needs
+        std::size_t needed = round_to_pages(size);
+        if (needed >= capacity || !extend_file(fd_, capacity_, needed)) {
+            int error = errno;
+            // drop any blocks a partial fallocate() left past the current mapping
+            int result = ftruncate(fd_, static_cast<off_t>(std::max(capacity_, size_.load())));
+            (void)result;
+            if (!out_of_space_) {
+                LOG(Error) << "Failed to reserve space for MappedFile, writes will fail ("
+                           << std::strerror(error) << ")";
+                out_of_space_ = true;
+            }
+            return false;
+        }
+        capacity = needed;
+    }
+    out_of_space_ = false;
+    void* data = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+        // give back the space, keeping what the current mapping covers
+        int result = ftruncate(fd_, static_cast<off_t>(std::max(capacity_, size_.load())));
+        (void)result;
+        return false;
+    }
+    Lock lock(mutex_);
+    if (data_) {
+        Mapping old = {data_, capacity_};
+        retired_.push_back(old);
+    }
+    data_     = static_cast<char*>(data);
+    capacity_ = capacity;
+    return true;
+#endif
+}
+
+void MappedFile::release() {
+#ifndef _WIN32
+    if (fd_ == -1)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        running_ = false;
+        wake_.notify_all();
+    }
+    if (thread_.joinable())
+        thread_.join();
+    for (std::size_t i = 0; i < retired_.size(); ++i)
+        munmap(retired_[i].data, retired_[i].capacity);
+    retired_.clear();
+    if (data_) {
+        munmap(data_, capacity_);
+        // drop the preallocated bytes that were never written
+        int result = ftruncate(fd_, static_cast<off_t>(size_.load()));
+        (void)result;
+    }
+    store_length(size_.load());
+    ::close(fd_);
+    fd_       = -1;
+    data_     = NULL;
+    capacity_ = 0;
+    size_     = 0;
+    synced_   = 0;
+    length_field_ = NO_LENGTH_FIELD;
+    out_of_space_ = false;
+#endif
+}
+
+void MappedFile::sync_thread_func() {
+    std::chrono::microseconds period(sync_period_.as_microseconds());
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (running_) {
+        wake_.wait_for(lock, period, [this] { return !running_; });
+        lock.unlock();
+        sync();
+        lock.lock();
+    }
+}
+
+} // namespace mel
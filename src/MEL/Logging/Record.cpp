@@ -17,6 +17,21 @@ namespace mel {
     {
     }
 
+    Record::Record(Severity severity,
+        const char* func,
+        size_t line,
+        const char* file,
+        Timestamp timestamp,
+        unsigned int tid)
+        : timestamp_(timestamp),
+        severity_(severity),
+        tid_(tid),
+        line_(line),
+        func_(func),
+        file_(file)
+    {
+    }
+
     Record::~Record() {
 
     }
@@ -51,6 +66,7 @@ namespace mel {
         return func_str_.c_str();
     }
 
+    const char* Record::get_raw_func() const { return func_; }
 
     const char* Record::get_file() const { return file_; }
 
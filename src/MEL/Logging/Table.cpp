@@ -1,24 +1,27 @@
 #include <MEL/Logging/Table.hpp>
 #include <MEL/Logging/Log.hpp>
+#include <algorithm>
 #include <sstream>
 
 namespace mel {
 
+namespace {
+
+/// Rows allocated by the first append, so small tables don't regrow often
+const std::size_t MIN_ROW_CAPACITY = 1024;
+
+} // namespace
+
 const std::string Table::table_id = "MEL::Table";
 
 Table::Table(const std::string &name, const std::vector<std::string> &col_names, const std::vector<std::vector<double>> &values) :
 	name_(name),
 	n_cols_(col_names.size()),
-	n_rows_(values.size()),
-	col_names_(col_names),
-	values_(values)
-{ 
-	if (!check_inner_dim(values, col_names.size())) {
-		LOG(Warning) << "Values given to Table do not match number of columns. Values not stored.";
-		n_rows_ = 0;
-		values_.clear();
-		return;
-	}
+	n_rows_(0),
+	row_capacity_(0),
+	col_names_(col_names)
+{
+	set_values(values);
 }
 
 const std::string &Table::name() const {
@@ -38,18 +41,25 @@ bool Table::set_col_names(const std::vector<std::string> &col_names) {
 	}
 	n_cols_ = col_names.size();
 	col_names_ = col_names;
+	values_.resize(n_cols_ * row_capacity_);
 	return true;
 }
 
-bool Table::set_values(const std::vector<std::vector<double>> &values) {	
+bool Table::set_values(const std::vector<std::vector<double>> &values) {
 	if (!check_inner_dim(values, n_cols_)) {
 		LOG(Warning) << "Values given to Table do not match number of columns. Values not stored.";
 		n_rows_ = 0;
-		values_.clear();
 		return false;
 	}
 	n_rows_ = values.size();
-	values_ = values;
+	row_capacity_ = n_rows_;
+	values_.resize(n_cols_ * row_capacity_);
+	for (std::size_t j = 0; j < n_cols_; ++j) {
+		double *col = col_data(j);
+		for (std::size_t i = 0; i < n_rows_; ++i) {
+			col[i] = values[i][j];
+		}
+	}
 	return true;
 }
 
@@ -58,39 +68,23 @@ bool Table::push_back_row(const std::vector<double> &row) {
 		LOG(Warning) << "Values given to Table do not match number of columns. Values not stored.";
 		return false;
 	}
+	grow_rows(1);
+	for (std::size_t j = 0; j < n_cols_; ++j) {
+		col_data(j)[n_rows_] = row[j];
+	}
 	n_rows_++;
-	values_.push_back(row);
 	return true;
 }
 
 bool Table::push_back_rows(const std::vector<std::vector<double>> &values) {
-	if (!check_inner_dim(values, n_cols_)) {
-		LOG(Warning) << "Values given to Table do not match number of columns. Values not stored.";
-		return false;
-	}
-	for (std::size_t i = 0; i < values.size(); ++i) {
-		n_rows_++;
-		values_.push_back(values[i]);
-	}
-	return true;
-
+	return insert_rows(values, n_rows_);
 }
 
 bool Table::insert_row(const std::vector<double> &row, std::size_t index) {
-	if (row.size() != n_cols_) {
-		LOG(Warning) << "Values given to Table do not match number of columns. Values not inserted.";
-		return false;
-	}
-	if (index > n_rows_) {
-		LOG(Warning) << "Row index given to Table outside of range. Values not inserted.";
-		return false;
-	}
-	values_.insert(values_.begin() + index, row);
-	n_rows_++;
-	return true;
+	return insert_rows(std::vector<std::vector<double>>(1, row), index);
 }
 
-bool Table::insert_rows(const std::vector<std::vector<double>> &rows, std::size_t index) {	
+bool Table::insert_rows(const std::vector<std::vector<double>> &rows, std::size_t index) {
 	if (!check_inner_dim(rows, n_cols_)) {
 		LOG(Warning) << "Values given to Table do not match number of columns. Values not inserted.";
 		return false;
@@ -99,7 +93,14 @@ bool Table::insert_rows(const std::vector<std::vector<double>> &rows, std::size_
 		LOG(Warning) << "Row index given to Table outside of range. Values not inserted.";
 		return false;
 	}
-	values_.insert(values_.begin() + index, rows.begin(), rows.end());
+	grow_rows(rows.size());
+	for (std::size_t j = 0; j < n_cols_; ++j) {
+		double *col = col_data(j);
+		std::copy_backward(col + index, col + n_rows_, col + n_rows_ + rows.size());
+		for (std::size_t i = 0; i < rows.size(); ++i) {
+			col[index + i] = rows[i][j];
+		}
+	}
 	n_rows_ += rows.size();
 	return true;
 }
@@ -111,13 +112,12 @@ bool Table::push_back_col(const std::string &col_name, const std::vector<double>
 	}
 	if (n_cols_ == 0) {
 		n_rows_ = col.size();
-		values_.resize(n_rows_);
+		row_capacity_ = std::max(row_capacity_, n_rows_);
 	}
 	n_cols_++;
-	col_names_.push_back(col_name);		
-	for (std::size_t i = 0; i < col.size(); ++i) {
-		values_[i].push_back(col[i]);
-	}
+	col_names_.push_back(col_name);
+	values_.resize(n_cols_ * row_capacity_);
+	std::copy(col.begin(), col.end(), col_data(n_cols_ - 1));
 	return true;
 }
 
@@ -132,15 +132,9 @@ bool Table::push_back_cols(const std::vector<std::string> &col_names, const std:
 	}
 	if (n_cols_ == 0) {
 		n_rows_ = values.size();
-		values_.resize(n_rows_);
+		row_capacity_ = std::max(row_capacity_, n_rows_);
 	}
-	n_cols_ += col_names.size();
-	for (std::size_t i = 0; i < values.size(); ++i) {
-		for (std::size_t j = 0; j < col_names.size(); ++j) {
-			values_[i].push_back(values[i][j]);
-		}		
-	}
-	return true;	
+	return insert_cols(col_names, values, n_cols_);
 }
 
 bool Table::insert_col(const std::string &col_name, const std::vector<double> &col, std::size_t index) {
@@ -153,14 +147,10 @@ bool Table::insert_col(const std::string &col_name, const std::vector<double> &c
 		return false;
 	}
 	col_names_.insert(col_names_.begin() + index, col_name);
-	if (n_cols_ == 0) {
-		n_rows_ = 1;
-		values_.resize(n_rows_);
-	}
-	for (std::size_t i = 0; i < n_rows_; ++i) {
-		values_[i].insert(values_[i].begin() + index, col[i]);
-	}
+	// a column is one block, so only the columns after it move
+	values_.insert(values_.begin() + index * row_capacity_, row_capacity_, 0.0);
 	n_cols_++;
+	std::copy(col.begin(), col.end(), col_data(index));
 	return true;
 }
 
@@ -177,15 +167,15 @@ bool Table::insert_cols(const std::vector<std::string> &col_names, const std::ve
 		LOG(Warning) << "Column index given to Table outside of range. Values not inserted.";
 		return false;
 	}
-	if (n_cols_ == 0) {
-		n_rows_ = cols.size();
-		values_.resize(n_rows_);
-	}
 	n_cols_ += col_names.size();
 	col_names_.insert(col_names_.begin() + index, col_names.begin(), col_names.end());
-	for (std::size_t i = 0; i < n_rows_; ++i) {
-		values_[i].insert(values_[i].begin() + index, cols[i].begin(), cols[i].end());
-	}	
+	values_.insert(values_.begin() + index * row_capacity_, col_names.size() * row_capacity_, 0.0);
+	for (std::size_t j = 0; j < col_names.size(); ++j) {
+		double *col = col_data(index + j);
+		for (std::size_t i = 0; i < n_rows_; ++i) {
+			col[i] = cols[i][j];
+		}
+	}
 	return true;
 }
 
@@ -204,46 +194,74 @@ const std::string &Table::get_col_name(std::size_t index) const {
 const double& Table::operator()(std::size_t row_index, std::size_t col_index) const {
 	if (row_index >= n_rows_ || col_index >= n_cols_) {
 		LOG(Warning) << "Indices given to Table outside of range. Returning last value within range.";
-		return values_[row_index >= n_rows_ ? n_rows_ : row_index][col_index >= n_cols_ ? n_cols_ : col_index];
+		return col_data(col_index >= n_cols_ ? n_cols_ - 1 : col_index)[row_index >= n_rows_ ? n_rows_ - 1 : row_index];
 	}
-	return values_[row_index][col_index];
+	return col_data(col_index)[row_index];
 }
 
-const std::vector<double> &Table::operator()(std::size_t row_index) const {
-	if (row_index >= n_rows_) {
-		LOG(Warning) << "Row index given to Table outside of range. Returning last row.";
-		return values_.back();
-	}
-	return values_[row_index];
+std::vector<double> Table::operator()(std::size_t row_index) const {
+	return get_row(row_index);
 }
 
-const std::vector<std::vector<double>> &Table::values() const {
-	return values_;
+std::vector<std::vector<double>> Table::values() const {
+	std::vector<std::vector<double>> values(n_rows_);
+	for (std::size_t i = 0; i < n_rows_; ++i) {
+		get_row(i, values[i]);
+	}
+	return values;
 }
 
 std::vector<double> Table::get_row(std::size_t index) const {
+	std::vector<double> row;
 	if (index >= n_rows_) {
-		LOG(Warning) << "Row index given to Table outside of range. Returning empty vector.";
-		return values_.back();
+		LOG(Warning) << "Row index given to Table outside of range. Returning last row.";
+		if (n_rows_ > 0)
+			get_row(n_rows_ - 1, row);
+		return row;
 	}
-	return values_[index];
+	get_row(index, row);
+	return row;
+}
+
+bool Table::get_row(std::size_t index, std::vector<double> &row) const {
+	if (index >= n_rows_) {
+		LOG(Warning) << "Row index given to Table outside of range. Row not copied.";
+		return false;
+	}
+	row.resize(n_cols_);
+	for (std::size_t j = 0; j < n_cols_; ++j) {
+		row[j] = col_data(j)[index];
+	}
+	return true;
 }
 
 std::vector<double> Table::get_col(std::size_t index) const {
+	Column column = col(index);
+	return std::vector<double>(column.begin(), column.end());
+}
+
+Table::Column Table::col(std::size_t index) const {
 	if (index >= n_cols_) {
-		LOG(Warning) << "Row index given to Table outside of range. Returning empty vector.";
-		return std::vector<double>();
+		LOG(Warning) << "Column index given to Table outside of range. Returning empty column.";
+		return Column(NULL, 0);
 	}
-	std::vector<double> col(n_rows_);
-	for (std::size_t i = 0; i < col.size(); ++i) {
-		col[i] = values_[i][index];
+	return Column(col_data(index), n_rows_);
+}
+
+void Table::reserve(std::size_t rows) {
+	if (rows <= row_capacity_)
+		return;
+	std::vector<double> values(n_cols_ * rows);
+	for (std::size_t j = 0; j < n_cols_; ++j) {
+		std::copy(col_data(j), col_data(j) + n_rows_, values.begin() + j * rows);
 	}
-	return col;
+	values_.swap(values);
+	row_capacity_ = rows;
 }
 
 void Table::pop_back_row() {
-	n_rows_--;
-	values_.pop_back();
+	if (n_rows_ > 0)
+		n_rows_--;
 }
 
 bool Table::erase_row(std::size_t index) {
@@ -251,27 +269,28 @@ bool Table::erase_row(std::size_t index) {
 		LOG(Warning) << "Row index given to Table outside of range. Values not erased.";
 		return false;
 	}
-	n_rows_--;
-	values_.erase(values_.begin() + index);
-	return true;
+	return erase_rows(index, index + 1);
 }
 
 bool Table::erase_rows(std::size_t index_first, std::size_t index_last) {
-	if (index_last >= n_rows_ || index_first >= index_last ) {
+	if (index_last > n_rows_ || index_first >= index_last ) {
 		LOG(Warning) << "Row indices given to Table outside of range or out of order. Values not erased.";
 		return false;
 	}
+	for (std::size_t j = 0; j < n_cols_; ++j) {
+		double *col = col_data(j);
+		std::copy(col + index_last, col + n_rows_, col + index_first);
+	}
 	n_rows_ -= index_last - index_first;
-	values_.erase(values_.begin() + index_first, values_.begin() + index_last);
 	return true;
 }
 
 void Table::pop_back_col() {
+	if (n_cols_ == 0)
+		return;
 	n_cols_--;
 	col_names_.pop_back();
-	for (std::size_t i = 0; i < values_.size(); ++i) {
-		values_[i].pop_back();
-	}
+	values_.resize(n_cols_ * row_capacity_);
 }
 
 bool Table::erase_col(std::size_t index) {
@@ -279,37 +298,30 @@ bool Table::erase_col(std::size_t index) {
 		LOG(Warning) << "Column index given to Table outside of range. Values not erased.";
 		return false;
 	}
-	n_rows_--;
-	col_names_.erase(col_names_.begin() + index);
-	for (std::size_t i = 0; i < values_.size(); ++i) {
-		values_[i].erase(values_[i].begin() + index);
-	}
-	return true;
+	return erase_cols(index, index + 1);
 }
 
 bool Table::erase_cols(std::size_t index_first, std::size_t index_last) {
-	if (index_last >= n_cols_ || index_first >= index_last) {
+	if (index_last > n_cols_ || index_first >= index_last) {
 		LOG(Warning) << "Column indices given to Table outside of range or out of order. Values not erased.";
 		return false;
 	}
 	n_cols_ -= index_last - index_first;
 	col_names_.erase(col_names_.begin() + index_first, col_names_.begin() + index_last);
-	for (std::size_t i = 0; i < values_.size(); ++i) {
-		values_[i].erase(values_[i].begin() + index_first, values_[i].begin() + index_last);
-	}
+	values_.erase(values_.begin() + index_first * row_capacity_, values_.begin() + index_last * row_capacity_);
 	return true;
 }
 
 void Table::clear() {
 	n_cols_ = 0;
 	n_rows_ = 0;
+	row_capacity_ = 0;
 	col_names_.clear();
 	values_.clear();
 }
 
 void Table::clear_values() {
 	n_rows_ = 0;
-	values_.clear();
 }
 
 std::size_t Table::row_count() const {
@@ -334,6 +346,20 @@ bool Table::check_inner_dim(const std::vector<std::vector<double>> &values, std:
 	return dim_valid;
 }
 
+void Table::grow_rows(std::size_t count) {
+	if (n_rows_ + count <= row_capacity_)
+		return;
+	reserve(std::max(n_rows_ + count, std::max(2 * row_capacity_, MIN_ROW_CAPACITY)));
+}
+
+double *Table::col_data(std::size_t index) {
+	return values_.empty() ? NULL : &values_[index * row_capacity_];
+}
+
+const double *Table::col_data(std::size_t index) const {
+	return values_.empty() ? NULL : &values_[index * row_capacity_];
+}
+
 std::ostream& operator<<(std::ostream& os, const Table& table) {
 	os << table.name() << ": " << table.n_rows_ << " rows by " << table.n_cols_ << " columns" << std::endl;
 	if (!table.empty()) {
@@ -342,7 +368,7 @@ std::ostream& operator<<(std::ostream& os, const Table& table) {
 		}
 		os << table.col_names_[table.n_cols_ - 1] << std::endl;
 	}
-	for (std::size_t i = 0; i < table.n_rows_; i++) {
+	for (std::size_t i = 0; i < table.n_rows_ && table.n_cols_ > 0; i++) {
 		for (size_t j = 0; j < table.n_cols_ - 1; ++j) {
 			os << table(i, j) << "\t";
 		}
@@ -352,4 +378,4 @@ std::ostream& operator<<(std::ostream& os, const Table& table) {
 	return os;
 }
 
-} // namespace mel
\ No newline at end of file
+} // namespace mel
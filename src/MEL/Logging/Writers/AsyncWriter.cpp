@@ -0,0 +1,89 @@
+#include <MEL/Logging/Writers/AsyncWriter.hpp>
+#include <MEL/Utility/System.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace mel {
+
+/// A queued Record
+struct AsyncWriter::Slot {
+    Timestamp timestamp;
+    Severity severity;
+    unsigned int tid;
+    size_t line;
+    const char* func;
+    const char* file;
+    char message[MESSAGE_BYTES];
+};
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
+AsyncWriter::AsyncWriter(Writer* writer, std::size_t capacity, Severity max_severity) :
+    Writer(max_severity),
+    writer_(writer),
+    ring_(capacity),
+    running_(true)
+{
+    thread_ = std::thread(&AsyncWriter::thread_func, this);
+}
+
+AsyncWriter::~AsyncWriter() {
+    running_ = false;
+    thread_.join();
+}
+
+void AsyncWriter::write(const Record& record) {
+    std::size_t pos;
+    Slot* slot = ring_.claim(pos);
+    if (!slot)
+        return;
+    slot->timestamp = record.get_timestamp();
+    slot->severity  = record.get_severity();
+    slot->tid       = record.get_tid_();
+    slot->line      = record.get_line();
+    slot->func      = record.get_raw_func();
+    slot->file      = record.get_file();
+    const char* message = record.get_message();
+    std::size_t length = std::min(std::strlen(message), MESSAGE_BYTES - 1);
+    std::memcpy(slot->message, message, length);
+    slot->message[length] = '\0';
+    ring_.publish(pos);
+}
+
+void AsyncWriter::set_max_severity(Severity severity) {
+    max_severity_ = severity;
+    writer_->set_max_severity(severity);
+}
+
+void AsyncWriter::flush() {
+    ring_.wait_drained();
+}
+
+uint64 AsyncWriter::get_dropped_count() const {
+    return ring_.get_dropped_count();
+}
+
+void AsyncWriter::thread_func() {
+    for (;;) {
+        // read before draining, see MpscRing
+        bool stop = !running_.load(std::memory_order_acquire);
+        if (drain() == 0) {
+            if (stop)
+                break;
+            sleep(milliseconds(1));
+        }
+    }
+}
+
+std::size_t AsyncWriter::drain() {
+    return ring_.drain([this](const Slot& slot) {
+        Record record(slot.severity, slot.func, slot.line, slot.file, slot.timestamp, slot.tid);
+        record << static_cast<const char*>(slot.message);
+        if (writer_->check_severity(record.get_severity()))
+            writer_->write(record);
+    });
+}
+
+} // namespace mel
@@ -0,0 +1,250 @@
+#include <MEL/Logging/Writers/RollingFileWriter.hpp>
+#include <MEL/Utility/System.hpp>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+namespace mel {
+
+//==============================================================================
+// HELPER FUNCTIONS
+//==============================================================================
+
+namespace {
+
+/// Source of writer IDs. IDs are never reused, so a thread's cached stages
+/// can't be mistaken for those of a new writer at the same address.
+std::atomic<uint64> next_writer_id(1);
+
+/// How often staged text is written when no stage fills up
+const std::chrono::milliseconds FLUSH_PERIOD(10);
+
+} // namespace
+
+struct RollingFileWriterBase::Stage {
+    Mutex mutex;       ///< held by the owning thread or the background thread
+    std::string text;  ///< formatted Records not yet written
+};
+
+namespace {
+
+/// A stage of this thread and the writer it belongs to
+struct StageCache {
+    uint64 writer_id;
+    std::shared_ptr<RollingFileWriterBase::Stage> stage;
+};
+
+/// This thread's stage for each writer it has logged to. A thread keeps one
+/// stage per writer for its whole life, so its Records stay in order.
+thread_local std::vector<StageCache> stage_cache;
+
+} // namespace
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
+RollingFileWriterBase::RollingFileWriterBase(const char* filename,
+                                             size_t max_file_size,
+                                             int max_files,
+                                             Severity max_severity) :
+    Writer(max_severity),
+    id_(next_writer_id.fetch_add(1)),
+    wake_requested_(false),
+    batches_(0),
+    running_(true),
+    dropped_(0),
+    file_size_(),
+    // set a lower limit for the max file size
+    max_file_size_((std::max)(static_cast<off_t>(max_file_size), static_cast<off_t>(1000))),
+    last_file_number_((std::max)(max_files - 1, 0)),
+    first_write_(true)
+{
+    split_file_name(filename, filename_no_ext_, file_ext_);
+    thread_ = std::thread(&RollingFileWriterBase::thread_func, this);
+}
+
+RollingFileWriterBase::~RollingFileWriterBase() {
+    stop();
+}
+
+void RollingFileWriterBase::flush() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    if (!running_)
+        return;
+    // the batch in progress may have missed text staged just before the call
+    uint64 target = batches_ + 2;
+    wake_requested_ = true;
+    wake_.notify_one();
+    while (running_ && batches_ < target)
+        wake_.wait(lock);
+}
+
+uint64 RollingFileWriterBase::get_dropped_count() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void RollingFileWriterBase::stage(const std::string& text) {
+    Stage* cached = NULL;
+    for (std::size_t i = 0; i < stage_cache.size(); ++i) {
+        if (stage_cache[i].writer_id == id_) {
+            cached = stage_cache[i].stage.get();
+            break;
+        }
+    }
+    if (!cached) {
+        // forget the stages of destroyed writers, which only we still hold
+        for (std::size_t i = 0; i < stage_cache.size();) {
+            if (stage_cache[i].stage.use_count() == 1) {
+                stage_cache[i] = stage_cache.back();
+                stage_cache.pop_back();
+            }
+            else {
+                ++i;
+            }
+        }
+        StageCache entry = {id_, make_stage()};
+        stage_cache.push_back(entry);
+        cached = entry.stage.get();
+    }
+    Stage& stage = *cached;
+    std::size_t size;
+    {
+        Lock lock(stage.mutex);
+        size = stage.text.size();
+        if (size + text.size() > MAX_STAGE_BYTES) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        stage.text += text;
+    }
+    // wake the thread only when crossing the threshold, not on every Record
+    if (size < STAGE_BYTES && size + text.size() >= STAGE_BYTES) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_requested_ = true;
+        wake_.notify_one();
+    }
+}
+
+void RollingFileWriterBase::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        if (!running_)
+            return;
+        running_ = false;
+        wake_.notify_all();
+    }
+    thread_.join();
+}
+
+std::shared_ptr<RollingFileWriterBase::Stage> RollingFileWriterBase::make_stage() {
+    std::shared_ptr<Stage> stage = std::make_shared<Stage>();
+    stage->text.reserve(STAGE_BYTES);
+    Lock lock(stages_mutex_);
+    stages_.push_back(stage);
+    return stage;
+}
+
+void RollingFileWriterBase::thread_func() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    for (;;) {
+        wake_.wait_for(lock, FLUSH_PERIOD, [this] { return wake_requested_ || !running_; });
+        bool stopping   = !running_;
+        wake_requested_ = false;
+        lock.unlock();
+        write_batch();
+        lock.lock();
+        ++batches_;
+        wake_.notify_all();
+        if (stopping)
+            break;
+    }
+    lock.unlock();
+    file_.close();
+}
+
+void RollingFileWriterBase::write_batch() {
+    {
+        Lock lock(stages_mutex_);
+        for (std::size_t i = 0; i < stages_.size();) {
+            Stage& stage = *stages_[i];
+            // checked first: once only the registry holds it, nothing more
+            // can be staged, so an empty stage can be removed
+            bool orphaned = stages_[i].use_count() == 1;
+            {
+                Lock stage_lock(stage.mutex);
+                // clear() keeps the capacity, so the stage doesn't reallocate
+                batch_ += stage.text;
+                stage.text.clear();
+            }
+            if (orphaned) {
+                stages_[i] = stages_.back();
+                stages_.pop_back();
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+    if (batch_.empty())
+        return;
+
+    if (first_write_) {
+        open_log_file();
+        first_write_ = false;
+    }
+    else if (last_file_number_ > 0 && file_size_ > max_file_size_ && -1 != file_size_) {
+        roll_log_files();
+    }
+
+    int bytes_written = file_.write(batch_);
+    if (bytes_written > 0)
+        file_size_ += bytes_written;
+    batch_.clear();
+}
+
+void RollingFileWriterBase::roll_log_files() {
+    file_.close();
+
+    std::string lastFileName = build_file_name(last_file_number_);
+    mel::File::unlink(lastFileName.c_str());
+
+    for (int fileNumber = last_file_number_ - 1; fileNumber >= 0; --fileNumber) {
+        std::string currentFileName = build_file_name(fileNumber);
+        std::string nextFileName    = build_file_name(fileNumber + 1);
+
+        File::rename(currentFileName.c_str(), nextFileName.c_str());
+    }
+
+    open_log_file();
+}
+
+void RollingFileWriterBase::open_log_file() {
+    std::string fileName = build_file_name();
+    file_size_           = file_.open(fileName.c_str());
+
+    if (0 == file_size_) {
+        int bytesWritten = file_.write(header());
+
+        if (bytesWritten > 0) {
+            file_size_ += bytesWritten;
+        }
+    }
+}
+
+std::string RollingFileWriterBase::build_file_name(int fileNumber) {
+    std::ostringstream ss;
+    ss << filename_no_ext_;
+
+    if (fileNumber > 0) {
+        ss << '.' << fileNumber;
+    }
+
+    if (!file_ext_.empty()) {
+        ss << '.' << file_ext_;
+    }
+
+    return ss.str();
+}
+
+} // namespace mel
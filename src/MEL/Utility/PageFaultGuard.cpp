@@ -0,0 +1,44 @@
+#include <MEL/Utility/PageFaultGuard.hpp>
+#include <MEL/Logging/Log.hpp>
+
+namespace mel {
+
+//==============================================================================
+// CLASS DEFINITIONS
+//==============================================================================
+
+PageFaultGuard::PageFaultGuard(const std::string& name) :
+    name_(name)
+{
+    reset();
+}
+
+int64 PageFaultGuard::check() {
+    PageFaults now = get_page_faults(true);
+    int64 major = now.major - last_.major;
+    int64 minor = now.minor - last_.minor;
+    last_ = now;
+    checks_ += 1;
+    if (MEL_UNLIKELY(major + minor > 0)) {
+        faults_.major += major;
+        faults_.minor += minor;
+        LOG(Warning) << name_ << " page faulted on iteration " << checks_ << " ("
+                     << major << " major, " << minor << " minor faults)";
+        // don't blame the loop for faults taken while logging
+        last_ = get_page_faults(true);
+    }
+    return major + minor;
+}
+
+PageFaults PageFaultGuard::get_faults() const {
+    return faults_;
+}
+
+void PageFaultGuard::reset() {
+    last_ = get_page_faults(true);
+    faults_.major = 0;
+    faults_.minor = 0;
+    checks_ = 0;
+}
+
+} // namespace mel
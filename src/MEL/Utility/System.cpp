@@ -1,4 +1,7 @@
 #include <MEL/Utility/System.hpp>
+#include <MEL/Communications/SharedMemory.hpp>
+#include <MEL/Logging/Log.hpp>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <iomanip>
@@ -12,12 +15,18 @@
 #include <errno.h>
 #include <pthread.h>
 #include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/syscall.h>
 #include <time.h>
 #include <unistd.h>
 #endif
 
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
 namespace mel {
 
 //==============================================================================
@@ -95,11 +104,11 @@ void sleep(Time duration) {
             CloseHandle(timer);
             // timeEndPeriod(tc.wPeriodMin); // to much overhead, not necessary?
         #else
-            uint64 usecs = duration.as_microseconds();
+            int64 nsecs = duration.as_nanoseconds();
             // Construct the time to wait
             timespec ti;
-            ti.tv_nsec = (usecs % 1000000) * 1000;
-            ti.tv_sec = usecs / 1000000;
+            ti.tv_nsec = static_cast<long>(nsecs % 1000000000);
+            ti.tv_sec = static_cast<time_t>(nsecs / 1000000000);
             // If nanosleep returns -1, we check errno. If it is EINTR
             // nanosleep was interrupted and has set ti to the remaining
             // duration. We continue sleeping until the complete duration
@@ -235,6 +244,97 @@ uint32 get_thread_id() {
     #endif
 }
 
+bool set_thread_affinity(int cpu) {
+    if (cpu < 0)
+        return false;
+    #ifdef _WIN32
+    if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+        return false;
+    DWORD_PTR mask = static_cast<DWORD_PTR>(1) << cpu;
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+    #elif defined(__linux__)
+    if (cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+    #else
+    return false;
+    #endif
+}
+
+namespace {
+
+/// Page size assumed when touching memory; smaller than or equal to the
+/// real one on every supported platform
+const std::size_t PAGE_BYTES = 4096;
+
+/// Touches #bytes of the stack below the caller, one page per frame. Not
+/// inlined or tail called, so every frame really is on the stack.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+char prefault_stack(std::size_t bytes) {
+    volatile char page[PAGE_BYTES];
+    page[0] = 0;
+    page[PAGE_BYTES - 1] = 0;
+    if (bytes > PAGE_BYTES)
+        page[0] = prefault_stack(bytes - PAGE_BYTES);
+    return page[0];
+}
+
+/// Allocates and touches #bytes of heap, then frees it back to the
+/// allocator, which keeps it for later allocations
+void prefault_heap(std::size_t bytes) {
+    if (bytes == 0)
+        return;
+#ifdef __GLIBC__
+    // never give freed memory back to the OS, and never serve allocations
+    // from their own mmap, so the reserve stays faulted in
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+    void* reserve = std::malloc(bytes);
+    if (!reserve) {
+        LOG(Warning) << "prepare_realtime could not allocate a " << bytes << " byte heap reserve";
+        return;
+    }
+    // volatile, so the stores aren't optimized away with the allocation
+    volatile char* pages = static_cast<volatile char*>(reserve);
+    for (std::size_t i = 0; i < bytes; i += PAGE_BYTES)
+        pages[i] = 0;
+    pages[bytes - 1] = 0;
+    std::free(reserve);
+}
+
+} // namespace
+
+bool prepare_realtime(std::size_t stack_bytes, std::size_t heap_bytes) {
+    PageFaults before = get_page_faults();
+    bool locked = true;
+    #ifdef _WIN32
+        // Windows has no mlockall(); pages stay in the working set while used
+        LOG(Warning) << "prepare_realtime can't lock memory on Windows";
+        locked = false;
+    #else
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            LOG(Warning) << "prepare_realtime could not lock memory (Error #" << errno << " - "
+                         << strerror(errno) << "). Run as root or raise RLIMIT_MEMLOCK.";
+            locked = false;
+        }
+    #endif
+    prefault_stack(stack_bytes);
+    prefault_heap(heap_bytes);
+    std::size_t shared = SharedMemory::prefault_all();
+    PageFaults after = get_page_faults();
+    LOG(Info) << "prepare_realtime " << (locked ? "locked memory and " : "")
+              << "faulted in " << stack_bytes << " stack, " << heap_bytes << " heap and "
+              << shared << " shared bytes (" << after.major - before.major << " major, "
+              << after.minor - before.minor << " minor faults)";
+    return locked;
+}
+
 //==============================================================================
 // PEROFRMANCE MONITORING FUNCTIONS (WINDOWS)
 //==============================================================================
@@ -348,6 +448,36 @@ uint64 ram_used_process() {
     return pmc.WorkingSetSize;
 }
 
+PageFaults get_page_faults(bool) {
+    PROCESS_MEMORY_COUNTERS pmc;
+    GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
+    PageFaults faults = {0, static_cast<int64>(pmc.PageFaultCount)};
+    return faults;
+}
+
+#else
+
+//==============================================================================
+// PEROFRMANCE MONITORING FUNCTIONS (UNIX)
+//==============================================================================
+
+PageFaults get_page_faults(bool this_thread) {
+    int who = RUSAGE_SELF;
+    #ifdef RUSAGE_THREAD
+    if (this_thread)
+        who = RUSAGE_THREAD;
+    #else
+    (void)this_thread;
+    #endif
+    PageFaults faults = {0, 0};
+    rusage usage;
+    if (getrusage(who, &usage) == 0) {
+        faults.major = usage.ru_majflt;
+        faults.minor = usage.ru_minflt;
+    }
+    return faults;
+}
+
 #endif
 
 }
@@ -18,57 +18,91 @@ import mmap
 import struct, array
 from Mutex import Mutex
 
+# synchronization modes (must match mel::MelShare::Mode)
+LOCKED    = 0 # reads and writes are guarded by a named mutex
+LOCK_FREE = 1 # single writer/multiple reader seqlock, writer never waits
+
 class MelShare(object):
 
-    def __init__(self, name, max_size = 256):
+    def __init__(self, name, max_size = 256, mode = LOCKED):
         self.name = name
+        self.max_size = max_size
+        self.mode = mode
         self.mutex = Mutex(name + '_mutex')
         self.shm = mmap.mmap(0, max_size, name, mmap.ACCESS_WRITE)
 
     def write_data(self, data):
-        self.shm.seek(0)
-        size = len(data) * 8
-        self.mutex.try_lock()
-        self.shm.write(struct.pack('I', size))
-        self.shm.write(array.array('d', data).tostring())
-        self.mutex.release()
+        self._write_frame(array.array('d', data).tostring())
 
     def read_data(self):
-        self.shm.seek(0)
-        self.mutex.try_lock()
-        size = struct.unpack('I', self.shm.read(4))[0]
+        frame = self._read_frame()
         data = []
-        if size > 0:
-            data = array.array('d', self.shm.read(size)).tolist()
-        self.mutex.release()
+        if len(frame) > 0:
+            data = array.array('d', frame).tolist()
         return data
 
     def write_message(self, message):
-        self.shm.seek(0)
-        message += '\0'
-        size = len(message)
-        self.mutex.try_lock()
-        self.shm.write(struct.pack('I', size))
-        self.shm.write(message)
-        self.mutex.release()
+        self._write_frame(message + '\0')
 
     def read_message(self):
-        self.shm.seek(0)
-        self.mutex.try_lock()
-        size = struct.unpack('I', self.shm.read(4))[0]
+        frame = self._read_frame()
         message = ''
-        if size > 0:
-            message = self.shm.read(size - 1)
-        self.mutex.release()
+        if len(frame) > 0:
+            message = frame[:-1]
         return message
 
     def get_size(self):
+        if self.mode == LOCK_FREE:
+            return len(self._read_frame())
         self.shm.seek(0)
         self.mutex.try_lock()
         size = struct.unpack('I', self.shm.read(4))[0]
         self.mutex.release()
         return size
 
+    def _write_frame(self, frame):
+        size = len(frame)
+        if self.mode == LOCK_FREE:
+            if size + 8 > self.max_size:
+                return
+            # odd sequence marks the frame as being written
+            self.shm.seek(0)
+            seq = struct.unpack('I', self.shm.read(4))[0]
+            self.shm.seek(0)
+            self.shm.write(struct.pack('I', (seq + 1) & 0xFFFFFFFF))
+            self.shm.write(struct.pack('I', size))
+            self.shm.write(frame)
+            self.shm.seek(0)
+            self.shm.write(struct.pack('I', (seq + 2) & 0xFFFFFFFF))
+        else:
+            if size + 4 > self.max_size:
+                return
+            self.shm.seek(0)
+            self.mutex.try_lock()
+            self.shm.write(struct.pack('I', size))
+            self.shm.write(frame)
+            self.mutex.release()
+
+    def _read_frame(self):
+        if self.mode == LOCK_FREE:
+            # retry until a frame is read without the writer touching it
+            while True:
+                self.shm.seek(0)
+                seq0, size = struct.unpack('II', self.shm.read(8))
+                if seq0 & 1:
+                    continue
+                frame = self.shm.read(min(size, self.max_size - 8))
+                self.shm.seek(0)
+                seq1 = struct.unpack('I', self.shm.read(4))[0]
+                if seq0 == seq1:
+                    return frame
+        self.shm.seek(0)
+        self.mutex.try_lock()
+        size = struct.unpack('I', self.shm.read(4))[0]
+        frame = self.shm.read(min(size, self.max_size - 4))
+        self.mutex.release()
+        return frame
+
 #==============================================================================
 # Example:
 #==============================================================================
@@ -0,0 +1,119 @@
+#include <MEL/Logging/DataLogger.hpp>
+#include <MEL/Logging/Table.hpp>
+#include <MEL/Core/Clock.hpp>
+#include <MEL/Utility/System.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace mel;
+
+// Benchmarks DataLogger CSV save and load of a 1M row x 20 column Table
+// against iostream code equivalent to the old implementation, which built
+// the whole file in an ostringstream and parsed every cell with its own
+// istringstream.
+
+static const std::size_t ROWS = 1000000;
+static const std::size_t COLS = 20;
+
+static void save_iostream(const Table& table, const std::string& filename) {
+    std::ostringstream oss;
+    oss << std::setprecision(6);
+    oss << DataLogger::make_csv_header(table);
+    for (std::size_t j = 0; j < table.col_count(); ++j)
+        oss << table.get_col_name(j) << (j + 1 < table.col_count() ? "," : "\r\n");
+    for (std::size_t i = 0; i < table.row_count(); ++i) {
+        for (std::size_t j = 0; j < table.col_count(); ++j)
+            oss << table(i, j) << (j + 1 < table.col_count() ? "," : "\r\n");
+    }
+    std::ofstream file(filename.c_str(), std::ios::binary);
+    file << oss.str();
+}
+
+static std::size_t load_iostream(const std::string& filename) {
+    std::ifstream input(filename.c_str());
+    std::string csv_line, el_str;
+    std::getline(input, csv_line);
+    std::getline(input, csv_line);
+    std::vector<std::vector<double>> values;
+    while (std::getline(input, csv_line)) {
+        std::istringstream iss(csv_line);
+        std::vector<double> row;
+        while (std::getline(iss, el_str, ',')) {
+            std::istringstream el_iss(el_str);
+            double value;
+            el_iss >> value;
+            row.push_back(value);
+        }
+        values.push_back(row);
+    }
+    return values.size();
+}
+
+static void report(const char* name, Time time, std::size_t bytes) {
+    double s = time.as_seconds();
+    std::cout << std::left << std::setw(22) << name << std::right
+              << std::fixed << std::setprecision(3) << std::setw(8) << s << " s"
+              << std::setprecision(1) << std::setw(10) << ROWS / s / 1e6 << " Mrow/s"
+              << std::setw(10) << bytes / s / 1e6 << " MB/s" << std::endl;
+}
+
+static std::size_t file_size(const std::string& filename) {
+    std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+    return static_cast<std::size_t>(file.tellg());
+}
+
+int main() {
+    std::vector<std::string> names;
+    for (std::size_t j = 0; j < COLS; ++j)
+        names.push_back("col" + std::to_string(j));
+    std::mt19937 rng(42);
+    std::normal_distribution<double> dist(0.0, 100.0);
+    std::vector<std::vector<double>> values(ROWS, std::vector<double>(COLS));
+    for (std::size_t i = 0; i < ROWS; ++i) {
+        for (std::size_t j = 0; j < COLS; ++j)
+            values[i][j] = dist(rng);
+    }
+    Table table("bench", names, values);
+    values.clear();
+    values.shrink_to_fit();
+
+    std::cout << "CSV " << ROWS << " rows x " << COLS << " cols" << std::endl;
+    Clock clock;
+
+    clock.restart();
+    save_iostream(table, "csv_bench_iostream.csv");
+    Time save_old = clock.get_elapsed_time();
+    std::size_t bytes = file_size("csv_bench_iostream.csv");
+    report("save (iostream)", save_old, bytes);
+
+    clock.restart();
+    DataLogger::write_to_csv(table, "csv_bench.csv", ".", false);
+    Time save_new = clock.get_elapsed_time();
+    report("save (DataLogger)", save_new, file_size("csv_bench.csv"));
+
+    clock.restart();
+    std::size_t rows = load_iostream("csv_bench_iostream.csv");
+    Time load_old = clock.get_elapsed_time();
+    report("load (iostream)", load_old, bytes);
+
+    Table loaded;
+    clock.restart();
+    DataLogger::read_from_csv(loaded, "csv_bench.csv", ".");
+    Time load_new = clock.get_elapsed_time();
+    report("load (DataLogger)", load_new, bytes);
+
+    std::cout << "save speedup: " << std::setprecision(1)
+              << save_old.as_seconds() / save_new.as_seconds() << "x, load speedup: "
+              << load_old.as_seconds() / load_new.as_seconds() << "x" << std::endl;
+    if (rows != ROWS || loaded.row_count() != ROWS || loaded.col_count() != COLS)
+        std::cout << "row count mismatch!" << std::endl;
+
+    std::remove("csv_bench_iostream.csv");
+    std::remove("csv_bench.csv");
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <MEL/Logging/Log.hpp>
+#include <MEL/Core/Clock.hpp>
+#include <MEL/Utility/Mutex.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mel;
+
+// Benchmarks LOG throughput with 1, 4 and 16 producer threads, writing
+// through RollingFileWriter against a writer equivalent to the old
+// implementation, which locked one Mutex and made one write() call per
+// Record on the calling thread.
+
+static const std::size_t RECORDS = 400000;  // total per run, split among threads
+
+class LockedFileWriter : public Writer {
+public:
+    LockedFileWriter(const char* filename) : Writer(Debug) {
+        file_.open(filename);
+    }
+
+    virtual void write(const Record& record) override {
+        Lock lock(mutex_);
+        file_.write(TxtFormatter::format(record));
+    }
+
+private:
+    Mutex mutex_;
+    File file_;
+};
+
+template <int instance>
+static void produce(std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        LOG_(instance, Info) << "sample " << i << " position " << 0.001 * i << " rad";
+}
+
+template <int instance>
+static Time run(std::size_t threads) {
+    Clock clock;
+    std::vector<std::thread> producers;
+    for (std::size_t t = 0; t < threads; ++t)
+        producers.push_back(std::thread(produce<instance>, RECORDS / threads));
+    for (std::size_t t = 0; t < threads; ++t)
+        producers[t].join();
+    return clock.get_elapsed_time();
+}
+
+static std::size_t count_lines(const char* filename) {
+    std::ifstream file(filename);
+    std::string line;
+    std::size_t lines = 0;
+    while (std::getline(file, line))
+        ++lines;
+    return lines;
+}
+
+static void report(const char* name, std::size_t threads, Time time) {
+    double s = time.as_seconds();
+    std::cout << std::left << std::setw(22) << name << std::right << std::setw(3)
+              << threads << " threads" << std::fixed << std::setprecision(3)
+              << std::setw(8) << s << " s" << std::setprecision(2) << std::setw(8)
+              << RECORDS / s / 1e6 << " Mrec/s" << std::endl;
+}
+
+int main() {
+    std::remove("log_bench_locked.log");
+    std::remove("log_bench.log");
+
+    static LockedFileWriter locked_writer("log_bench_locked.log");
+    static RollingFileWriter<TxtFormatter> rolling_writer("log_bench.log");
+    init_logger<1>(Verbose, &locked_writer);
+    init_logger<2>(Verbose, &rolling_writer);
+
+    std::cout << "LOG " << RECORDS << " records" << std::endl;
+    const std::size_t thread_counts[] = {1, 4, 16};
+    for (std::size_t i = 0; i < 3; ++i) {
+        std::size_t threads = thread_counts[i];
+        Time locked = run<1>(threads);
+        report("locked write", threads, locked);
+
+        Clock clock;
+        Time staged = run<2>(threads);
+        report("RollingFileWriter", threads, staged);
+        rolling_writer.flush();
+        report("  including flush", threads, clock.get_elapsed_time());
+
+        std::cout << "speedup: " << std::setprecision(1)
+                  << locked.as_seconds() / staged.as_seconds() << "x" << std::endl;
+    }
+
+    // every Record reaches the file
+    std::size_t expected = 3 * RECORDS + 1;
+    std::size_t lines = count_lines("log_bench.log");
+    bool complete = lines + rolling_writer.get_dropped_count() == expected;
+    if (!complete)
+        std::cout << "line count mismatch: " << lines << " of " << expected << std::endl;
+    std::cout << "dropped: " << rolling_writer.get_dropped_count() << std::endl;
+
+    std::remove("log_bench_locked.log");
+    std::remove("log_bench.log");
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#include <MEL/Communications/SocketSelector.hpp>
+#include <MEL/Communications/UdpSocket.hpp>
+#include <MEL/Core/Clock.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/select.h>
+#endif
+
+using namespace mel;
+
+// Benchmarks SocketSelector against a plain select() loop equivalent to the
+// old implementation. N UDP sockets are watched while one random socket at a
+// time receives a datagram, which is the typical server workload.
+
+/// UdpSocket that exposes its handle for the select() baseline
+class BenchSocket : public UdpSocket {
+public:
+    using UdpSocket::get_handle;
+};
+
+typedef std::vector<std::unique_ptr<BenchSocket>> Sockets;
+
+static const int ITERATIONS = 20000;
+
+static void open_sockets(Sockets& sockets, std::size_t count) {
+    sockets.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        sockets.emplace_back(new BenchSocket);
+        sockets.back()->bind(Socket::AnyPort, IpAddress::LocalHost);
+        sockets.back()->set_blocking(false);
+    }
+}
+
+static double bench_selector(Sockets& sockets, UdpSocket& sender) {
+    SocketSelector selector;
+    for (std::size_t i = 0; i < sockets.size(); ++i)
+        selector.add(*sockets[i]);
+    char byte = 0, buffer[16];
+    std::size_t received;
+    IpAddress address;
+    unsigned short port;
+    Clock clock;
+    for (int i = 0; i < ITERATIONS; ++i) {
+        BenchSocket& target = *sockets[std::rand() % sockets.size()];
+        sender.send(&byte, 1, IpAddress::LocalHost, target.get_local_port());
+        if (selector.wait(seconds(1))) {
+            for (std::size_t j = 0; j < sockets.size(); ++j) {
+                if (selector.is_ready(*sockets[j]))
+                    sockets[j]->receive(buffer, sizeof(buffer), received, address, port);
+            }
+        }
+    }
+    return static_cast<double>(clock.get_elapsed_time().as_microseconds()) / ITERATIONS;
+}
+
+static double bench_select(Sockets& sockets, UdpSocket& sender) {
+#ifdef _WIN32
+    return bench_selector(sockets, sender);
+#else
+    fd_set all, ready;
+    FD_ZERO(&all);
+    int max_handle = 0;
+    for (std::size_t i = 0; i < sockets.size(); ++i) {
+        if (sockets[i]->get_handle() >= FD_SETSIZE)
+            return -1;
+        FD_SET(sockets[i]->get_handle(), &all);
+        max_handle = std::max(max_handle, sockets[i]->get_handle());
+    }
+    char byte = 0, buffer[16];
+    std::size_t received;
+    IpAddress address;
+    unsigned short port;
+    Clock clock;
+    for (int i = 0; i < ITERATIONS; ++i) {
+        BenchSocket& target = *sockets[std::rand() % sockets.size()];
+        sender.send(&byte, 1, IpAddress::LocalHost, target.get_local_port());
+        timeval time;
+        time.tv_sec  = 1;
+        time.tv_usec = 0;
+        ready = all;
+        if (select(max_handle + 1, &ready, NULL, NULL, &time) > 0) {
+            for (std::size_t j = 0; j < sockets.size(); ++j) {
+                if (FD_ISSET(sockets[j]->get_handle(), &ready))
+                    sockets[j]->receive(buffer, sizeof(buffer), received, address, port);
+            }
+        }
+    }
+    return static_cast<double>(clock.get_elapsed_time().as_microseconds()) / ITERATIONS;
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    UdpSocket sender;
+    sender.bind(Socket::AnyPort, IpAddress::LocalHost);
+    const std::size_t counts[] = {16, 64, 256, 900};
+    std::cout << std::setw(10) << "sockets" << std::setw(16) << "selector [us]"
+              << std::setw(16) << "select [us]" << std::endl;
+    for (std::size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        Sockets sockets;
+        open_sockets(sockets, counts[i]);
+        double selector = bench_selector(sockets, sender);
+        double select   = bench_select(sockets, sender);
+        std::cout << std::setw(10) << counts[i] << std::setw(16) << selector
+                  << std::setw(16) << select << std::endl;
+    }
+    return 0;
+}